@@ -0,0 +1,57 @@
+/*
+crc-benchmark.cpp - host benchmark of table driven CRC
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "frames/frame.hpp"
+#include "test.hpp"    // hexFrame()
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+// CRC-16/MCRF4XX benchmark, bitwise reference vs table driven Crc16
+// FrameFixer checks one CRC per fix hypothesis, so time per frame = time per hypothesis
+
+#define BENCHMARK_ROUNDS 100000
+
+static volatile uint16_t sink;
+
+/** @return ns per CRC of `calculate` over frame without its CRC */
+template <typename Calculate>
+static double crcCost(std::vector<uint8_t>& frame, Calculate calculate) {
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t idx = 0; idx < BENCHMARK_ROUNDS; idx++) {
+		sink = calculate(frame.data(), frame.size() - 2);
+	}
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCHMARK_ROUNDS;
+}
+
+static void benchmark(const char* name, std::vector<uint8_t> frame) {
+	double bitwise = crcCost(frame, [](uint8_t* data, size_t len) { return EstiaFrame::crc16(data, len); });
+	double table = crcCost(frame, [](uint8_t* data, size_t len) { return Crc16::calculate(data, len); });
+	printf("%s (%zu Bytes), per frame/hypothesis:\n", name, frame.size());
+	printf("  bitwise: %.1f ns\n", bitwise);
+	printf("  table:   %.1f ns\n", table);
+	printf("  speedup: x%.2f\n", bitwise / table);
+}
+
+int main() {
+	benchmark("status frame", hexFrame(capturedStatus[0].frame));
+	benchmark("ack frame", hexFrame(CAPTURED_ACK));
+	return 0;
+}
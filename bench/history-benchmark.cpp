@@ -0,0 +1,109 @@
+/*
+history-benchmark.cpp - host benchmark of delta encoded sensor history
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "sensor-history.hpp"
+#include <chrono>
+#include <stdio.h>
+
+// HistoryRing vs plain array of samples, synthetic trace: 10s polling with jitter,
+// value changes mostly by 0 or +-1, occasional jumps
+
+#define BENCHMARK_SAMPLES 8640          // 24h of 10s polling
+#define BENCHMARK_ROUNDS 100
+#define BENCHMARK_RING_BYTES 16384
+#define BENCHMARK_ARRAY_SAMPLES 1024    // plain array ring, as on device
+
+struct Trace {
+	uint32_t seed;
+	uint32_t time;
+	int16_t value;
+
+	void reset() {
+		seed = 12345;
+		time = 0;
+		value = 400;
+	}
+	uint32_t random() {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+	void next() {
+		uint32_t rnd = random();
+		time += 10000 + (rnd & 0x3ff) - 512;    // 10s +-0.5s
+		uint8_t change = rnd % 32;
+		if (change == 0) {
+			value += 20;    // e.g. defrost start
+		} else if (change == 1) {
+			value -= 20;
+		} else if (change < 10) {
+			value += 1;
+		} else if (change < 18) {
+			value -= 1;
+		}
+	}
+};
+
+static HistoryRing::Sample samples[BENCHMARK_ARRAY_SAMPLES];
+static volatile int16_t sink;
+
+static double elapsedNs(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** @return ns per sample of trace generation plus `append` */
+template <typename Append>
+static double appendCost(Append append) {
+	Trace trace;
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+		trace.reset();
+		for (uint32_t idx = 0; idx < BENCHMARK_SAMPLES; idx++) {
+			trace.next();
+			append(idx, trace);
+		}
+	}
+	return elapsedNs(start) / (BENCHMARK_SAMPLES * BENCHMARK_ROUNDS);
+}
+
+int main() {
+	HistoryRing history;
+	if (!history.allocate(BENCHMARK_RING_BYTES)) {
+		printf("history allocation failed\n");
+		return 1;
+	}
+	// trace generation only, subtracted from append costs
+	double generator = appendCost([](uint32_t, const Trace& trace) { sink = trace.value; });
+	double array = appendCost([](uint32_t idx, const Trace& trace) {
+		samples[idx % BENCHMARK_ARRAY_SAMPLES] = {trace.time, trace.value};
+	});
+	sink = samples[0].value;
+	double ring = appendCost([&](uint32_t idx, const Trace& trace) {
+		if (idx == 0) { history.clear(); }
+		history.append(trace.time, trace.value);
+	});
+
+	printf("%u samples appended, %zu kept in %zu Bytes ring\n", BENCHMARK_SAMPLES, history.size(), history.getCapacity());
+	printf("bytes per sample:\n");
+	printf("  array:   %zu\n", sizeof(HistoryRing::Sample));
+	printf("  history: %.2f\n", static_cast<double>(history.bytes()) / history.size());
+	printf("append per sample:\n");
+	printf("  array:   %.1f ns\n", array - generator);
+	printf("  history: %.1f ns\n", ring - generator);
+	return 0;
+}
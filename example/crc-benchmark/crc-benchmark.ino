@@ -0,0 +1,38 @@
+#include <estia-serial.h>
+
+// CRC-16/MCRF4XX benchmark, bitwise reference vs table driven Crc16
+// FrameFixer checks one CRC per fix hypothesis, so time per frame = time per hypothesis
+
+#define BENCHMARK_ROUNDS 10000
+
+uint8_t statusFrame[FRAME_STATUS_LEN] = {0xa0, 0x00, 0x58, 0x19, 0x00, 0x08, 0x00, 0x00, 0xfe, 0x03, 0xc6, 0xc1, 0x30, 0x10, 0x78, 0x5c,
+                                         0x7a, 0x78, 0x5c, 0x7a, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe9, 0x89, 0x5e, 0x00, 0x41, 0x4a};
+uint8_t ackFrame[FRAME_ACK_LEN] = {0xa0, 0x00, 0x18, 0x09, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0xa1, 0x00, 0x41, 0xc1, 0x95};
+
+void setup() {
+	Serial.begin(115200);
+	Serial.println("");
+	benchmark("status frame", statusFrame, sizeof(statusFrame));
+	benchmark("ack frame", ackFrame, sizeof(ackFrame));
+}
+
+void loop() {
+}
+
+void benchmark(const char* name, uint8_t* frame, size_t len) {
+	volatile uint16_t crc = 0;
+	uint32_t timer = micros();
+	for (uint32_t idx = 0; idx < BENCHMARK_ROUNDS; idx++) {
+		crc = EstiaFrame::crc16(frame, len - 2);
+	}
+	uint32_t bitwise = micros() - timer;
+	timer = micros();
+	for (uint32_t idx = 0; idx < BENCHMARK_ROUNDS; idx++) {
+		crc = Crc16::calculate(frame, len - 2);
+	}
+	uint32_t table = micros() - timer;
+	Serial.printf("%s (%u Bytes), per frame/hypothesis:\n", name, static_cast<unsigned int>(len));
+	Serial.printf("  bitwise: %.2f us\n", static_cast<float>(bitwise) / BENCHMARK_ROUNDS);
+	Serial.printf("  table:   %.2f us\n", static_cast<float>(table) / BENCHMARK_ROUNDS);
+	Serial.printf("  speedup: x%.2f\n", static_cast<float>(bitwise) / table);
+}
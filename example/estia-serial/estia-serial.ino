@@ -9,58 +9,54 @@
 #endif
 
 EstiaSerial estiaSerial(ESTIA_SERIAL_RX, ESTIA_SERIAL_TX);
-u_long requestDataOffInterval = 300000;    // data update interval when heat pump is doing nothing
-u_long requestDataTimer = requestDataOffInterval;
-bool requestData = false;
 
 void setup() {
 	Serial.begin(115200);
 	Serial.println("");
+	estiaSerial.onRawFrame([](const FrameView& frame) {
+		EstiaFrame::printHex(Serial, frame);
+		Serial.println();
+	});
+	estiaSerial.onAck([](uint16_t frameCode) {
+		Serial.printf("frame 0x%04X acked\n", frameCode);
+	});
+	estiaSerial.onStatus([](const StatusData& data) {
+		printStatusData(data);
+	});
+	// fast changing data every 10s, slow every 1min, outside temperature every 2min, counters every hour
+	for (const char* name : {"cmp", "wf", "two"}) {
+		estiaSerial.pollSensor(name, 10000, PollScheduler::priority_high);
+	}
+	for (const char* name : {"tc", "twi", "tho", "lps", "te", "td", "ts", "tl", "fan1", "pmv", "hps"}) {
+		estiaSerial.pollSensor(name, 60000);
+	}
+	estiaSerial.pollSensor("to", 120000);
+	for (const char* name : {"hp_on_time", "hw_cmp_on_time", "heat_cmp_on_time", "pump1_on_time"}) {
+		estiaSerial.pollSensor(name, 3600000, PollScheduler::priority_low);
+	}
+	estiaSerial.onSensor([](uint8_t code, int16_t value) {
+		uint8_t idx = SensorStore::index(code);
+		if (idx == SENSOR_NONE) { return; }
+		SensorDescriptor sensor = SensorStore::descriptor(idx);
+		Serial.printf("%s :", sensor.name);
+		// data is error code skip multiplier
+		if (value <= EstiaSerial::err_not_exist) {
+			Serial.print(value);
+		} else {
+			Serial.print(value * sensor.multiplier);
+		}
+		Serial.println();
+	});
 	estiaSerial.begin();
 	Serial.println("Setup done!");
 }
 
 void loop() {
-	switch (estiaSerial.sniffer()) {
-	case EstiaSerial::sniff_frame_pending:
-		Serial.println(EstiaFrame::stringify(estiaSerial.getSniffedFrame()));
-		if (estiaSerial.frameAck != 0) {
-			Serial.printf("frame 0x%04X acked\n", estiaSerial.getAck());
-		} else if (estiaSerial.newStatusData) {
-			StatusData data = estiaSerial.getStatusData();
-			printStatusData(data);
-			// request sensors data after extended status data received (every 30s)
-			if (data.extendedData) {
-				if (data.pump1 ||                                                      // when pump1 is on every 30s
-				    millis() - requestDataTimer >= requestDataOffInterval - 1000) {    // when pump1 is off every 5min
-					requestDataTimer = millis();
-					// request update for default data points (config.h -> SENSORS_DATA_TO_REQUEST)
-					estiaSerial.requestSensorsData();
-					// or request update for chosen data points
-					// estiaSerial.requestSensorsData({"twi", "two", "wf"}, true)
-				}
-			}
-		}
-		break;
-	case EstiaSerial::sniff_idle:
-		// to avoid data collisions write and request data here
-		if (estiaSerial.newSensorsData) {
-			for (auto& sensor : estiaSerial.getSensorsData()) {
-				Serial.printf("%s :", sensor.first.c_str());
-				// data is error code skip multiplier
-				if (sensor.second.value <= EstiaSerial::err_not_exist) {
-					Serial.print(sensor.second.value);
-				} else {
-					Serial.print(sensor.second.value * sensor.second.multiplier);
-				}
-				Serial.println();
-			}
-		}
-		break;
-	}
+	// handlers are called from sniffer()
+	estiaSerial.sniffer();
 }
 
-void printStatusData(StatusData& data) {
+void printStatusData(const StatusData& data) {
 	if (data.error == StatusFrame::err_ok) {
 		Serial.printf("operationMode:     %s\n", data.operationMode == 0x06 ? "heating" : "cooling");
 		Serial.printf("cooling:           %s\n", data.cooling ? "on" : "off");
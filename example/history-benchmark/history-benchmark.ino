@@ -0,0 +1,94 @@
+#include <estia-serial.h>
+
+// HistoryRing benchmark, delta encoded ring vs plain array of samples
+// synthetic trace: 10s polling with jitter, value changes mostly by 0 or +-1, occasional jumps
+
+#define BENCHMARK_SAMPLES 8640          // 24h of 10s polling
+#define BENCHMARK_RING_BYTES 16384
+#define BENCHMARK_ARRAY_SAMPLES 1024    // plain array ring, 24h does not fit ESP8266 RAM
+
+struct Trace {
+	uint32_t seed;
+	uint32_t time;
+	int16_t value;
+
+	void reset() {
+		seed = 12345;
+		time = 0;
+		value = 400;
+	}
+	uint32_t random() {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+	void next() {
+		uint32_t rnd = random();
+		time += 10000 + (rnd & 0x3ff) - 512;    // 10s +-0.5s
+		uint8_t change = rnd % 32;
+		if (change == 0) {
+			value += 20;    // e.g. defrost start
+		} else if (change == 1) {
+			value -= 20;
+		} else if (change < 10) {
+			value += 1;
+		} else if (change < 18) {
+			value -= 1;
+		}
+	}
+};
+
+HistoryRing history;
+HistoryRing::Sample samples[BENCHMARK_ARRAY_SAMPLES];
+Trace trace;
+
+void setup() {
+	Serial.begin(115200);
+	Serial.println("");
+	if (!history.allocate(BENCHMARK_RING_BYTES)) {
+		Serial.println("history allocation failed");
+		return;
+	}
+	benchmark();
+}
+
+void loop() {
+}
+
+void benchmark() {
+	// trace generation only, subtracted from append times
+	volatile int16_t sink = 0;
+	trace.reset();
+	uint32_t timer = micros();
+	for (uint32_t idx = 0; idx < BENCHMARK_SAMPLES; idx++) {
+		trace.next();
+		sink = trace.value;
+	}
+	uint32_t generator = micros() - timer;
+
+	trace.reset();
+	timer = micros();
+	for (uint32_t idx = 0; idx < BENCHMARK_SAMPLES; idx++) {
+		trace.next();
+		samples[idx % BENCHMARK_ARRAY_SAMPLES] = {trace.time, trace.value};
+	}
+	uint32_t array = micros() - timer - generator;
+	sink = samples[0].value;
+
+	trace.reset();
+	timer = micros();
+	for (uint32_t idx = 0; idx < BENCHMARK_SAMPLES; idx++) {
+		trace.next();
+		history.append(trace.time, trace.value);
+	}
+	uint32_t ring = micros() - timer - generator;
+	(void)sink;
+
+	Serial.printf("%u samples appended, %u kept in %u Bytes ring\n", BENCHMARK_SAMPLES, static_cast<unsigned int>(history.size()),
+	              static_cast<unsigned int>(history.getCapacity()));
+	Serial.printf("bytes per sample:\n");
+	Serial.printf("  array:   %u\n", static_cast<unsigned int>(sizeof(HistoryRing::Sample)));
+	Serial.printf("  history: %.2f\n", static_cast<float>(history.bytes()) / history.size());
+	Serial.printf("append per sample:\n");
+	Serial.printf("  array:   %.3f us\n", static_cast<float>(array) / BENCHMARK_SAMPLES);
+	Serial.printf("  history: %.3f us\n", static_cast<float>(ring) / BENCHMARK_SAMPLES);
+}
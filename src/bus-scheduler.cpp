@@ -0,0 +1,197 @@
+/*
+bus-scheduler.cpp - Estia R32 heat pump listen-before-talk transmit scheduler
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "bus-scheduler.hpp"
+
+BusScheduler::BusScheduler()
+    : heartbeatPeriod(0)
+    , lastHeartbeat(0)
+    , heartbeatSeen(false)
+    , periodMismatch(0)
+    , burstLength(0)
+    , burstEnd(0)
+    , txStart(0)
+    , txEnd(0)
+    , txLength(0)
+    , txWindow(false)
+    , transmissions(0)
+    , collisions(0)
+    , retries(0) {
+}
+
+/** @return frame transmit time (us) */
+uint32_t BusScheduler::airtime(uint8_t length) {
+	return length * ESTIA_SERIAL_CHAR_TIME;
+}
+
+/**
+* @param kind classified frame
+* @param endTime frame last byte receive time (us)
+* @param length frame length
+* @param crcValid frame CRC matches (after fixing)
+*/
+void BusScheduler::frameReceived(FrameClassifier::FrameKind kind, uint32_t endTime, uint8_t length, bool crcValid) {
+	uint32_t startTime = endTime - airtime(length);
+
+	if (txWindow) {
+		if (ownEcho(startTime, length)) { return; }    // sent with RX enabled, not a collision
+		// frame overlapping own transmission
+		if (static_cast<int32_t>(endTime - txStart) > 0 && static_cast<int32_t>(txEnd - startTime) > 0) {
+			collisions++;
+			txWindow = false;
+		} else if (static_cast<int32_t>(startTime - txEnd) >= 0) {
+			txWindow = false;
+		}
+	}
+	if (!crcValid) { return; }
+
+	switch (kind) {
+	case FrameClassifier::frame_heartbeat:
+		learnHeartbeat(startTime);
+		burstEnd = endTime;
+		if (endTime - startTime > burstLength) { burstLength = endTime - startTime; }
+		break;
+
+	case FrameClassifier::frame_status:
+	case FrameClassifier::frame_short_status:
+	case FrameClassifier::frame_status_update:
+	case FrameClassifier::frame_data_response:
+	case FrameClassifier::frame_ack:
+		// master frames sent back to back after heartbeat extend burst
+		if (heartbeatSeen && static_cast<int32_t>(startTime - burstEnd) <= BUS_BURST_GAP) {
+			burstEnd = endTime;
+			if (endTime - lastHeartbeat > burstLength) { burstLength = endTime - lastHeartbeat; }
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void BusScheduler::learnHeartbeat(uint32_t start) {
+	if (!heartbeatSeen) {
+		heartbeatSeen = true;
+		lastHeartbeat = start;
+		return;
+	}
+	uint32_t interval = start - lastHeartbeat;
+	if (interval < BUS_HEARTBEAT_MIN_PERIOD) { return; }
+
+	lastHeartbeat = start;
+	burstLength -= burstLength / 16;    // forget bursts not seen any more
+	if (heartbeatPeriod == 0) {
+		heartbeatPeriod = interval;
+		return;
+	}
+	uint32_t diff = interval > heartbeatPeriod ? interval - heartbeatPeriod : heartbeatPeriod - interval;
+	if (diff <= heartbeatPeriod / 4) {
+		heartbeatPeriod = heartbeatPeriod - heartbeatPeriod / 4 + interval / 4;    // EWMA 1/4
+		periodMismatch = 0;
+		return;
+	}
+	// missed heartbeat (multiple of period) is not a mismatch
+	uint32_t periods = (interval + heartbeatPeriod / 2) / heartbeatPeriod;
+	uint32_t expected = periods * heartbeatPeriod;
+	uint32_t offset = interval > expected ? interval - expected : expected - interval;
+	if (periods > 1 && offset <= heartbeatPeriod / 4) { return; }
+
+	if (++periodMismatch >= BUS_PERIOD_MISMATCH_LIMIT) {
+		heartbeatPeriod = interval;
+		burstLength = 0;
+		periodMismatch = 0;
+	}
+}
+
+// own transmission received back, same length and starting at transmit start (receive time is estimated)
+bool BusScheduler::ownEcho(uint32_t startTime, uint8_t length) const {
+	if (length != txLength) { return false; }
+
+	int32_t offset = static_cast<int32_t>(startTime - txStart);
+	return offset <= static_cast<int32_t>(BUS_ECHO_TOLERANCE) && offset >= -static_cast<int32_t>(BUS_ECHO_TOLERANCE);
+}
+
+// master sends frames back to back, burst ends after BUS_BURST_GAP of silence
+bool BusScheduler::inBurst(uint32_t now) const {
+	if (!heartbeatSeen) { return false; }
+
+	if (now - burstEnd < BUS_BURST_GAP) { return true; }
+	if (heartbeatPeriod == 0) { return false; }
+
+	// predicted heartbeat not received (late, in progress or lost), keep out of learned burst
+	uint32_t predicted = now - (now - lastHeartbeat) % heartbeatPeriod;
+	uint32_t burst = burstLength > airtime(FRAME_HEARTBEAT_LEN) ? burstLength : airtime(FRAME_HEARTBEAT_LEN);
+	return predicted != lastHeartbeat && now - predicted < burst + BUS_BURST_GAP;
+}
+
+/** Predicted next heartbeat start (us), `now` if period is not learned. */
+uint32_t BusScheduler::nextHeartbeat(uint32_t now) const {
+	if (!heartbeatSeen || heartbeatPeriod == 0) { return now; }
+
+	uint32_t sinceLast = (now - lastHeartbeat) % heartbeatPeriod;
+	return now + (heartbeatPeriod - sinceLast);
+}
+
+/**
+* @param now current time (us)
+* @param idleTime line silence (us)
+* @param length frame to send length
+* @param responseLength expected answer length, `0` no answer
+*/
+bool BusScheduler::clearToSend(uint32_t now, uint32_t idleTime, uint8_t length, uint8_t responseLength) {
+	if (idleTime < BUS_GUARD_TIME) { return false; }
+	if (!heartbeatSeen || heartbeatPeriod == 0) { return true; }    // cadence not learned yet
+
+	uint32_t needed = BUS_GUARD_TIME + airtime(length);
+	uint32_t answer = responseLength != 0 ? BUS_TURNAROUND_TIME + airtime(responseLength) : 0;
+	// answer can not fit even after heartbeat alone, fit own frame only
+	if (needed + answer + airtime(FRAME_HEARTBEAT_LEN) + BUS_BURST_GAP <= heartbeatPeriod) { needed += answer; }
+	return !inBurst(now) && nextHeartbeat(now) - now >= needed;
+}
+
+void BusScheduler::transmitted(uint32_t startTime, uint8_t length) {
+	transmissions++;
+	txStart = startTime;
+	txEnd = startTime + airtime(length);
+	txLength = length;
+	txWindow = true;
+}
+
+void BusScheduler::retried() {
+	retries++;
+}
+
+uint32_t BusScheduler::getHeartbeatPeriod() const {
+	return heartbeatPeriod;
+}
+
+uint32_t BusScheduler::getBurstLength() const {
+	return burstLength;
+}
+
+uint32_t BusScheduler::getTransmissions() const {
+	return transmissions;
+}
+
+uint32_t BusScheduler::getCollisions() const {
+	return collisions;
+}
+
+uint32_t BusScheduler::getRetries() const {
+	return retries;
+}
@@ -0,0 +1,74 @@
+/*
+bus-scheduler.hpp - Estia R32 heat pump listen-before-talk transmit scheduler
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "frames/frame-classifier.hpp"
+#include "transport/transport.hpp"
+
+#define BUS_GUARD_TIME (3 * ESTIA_SERIAL_CHAR_TIME)    // us, minimum line silence before transmit
+#define BUS_TURNAROUND_TIME 20000                      // us, master response delay margin
+#define BUS_HEARTBEAT_MIN_PERIOD 100000                // us, shorter intervals are ignored
+#define BUS_PERIOD_MISMATCH_LIMIT 3                    // off period heartbeats before relearning
+#define BUS_BURST_GAP 20000                            // us, master frame starting within gap after previous one extends burst
+#define BUS_ECHO_TOLERANCE (2 * ESTIA_SERIAL_CHAR_TIME)    // us, own frame received back starts this close to transmit start
+
+/** Listen-before-talk transmit scheduler.
+*
+* Learns master cadence from sniffed traffic: heartbeat period and length of
+* master burst following heartbeat (status frames sent back to back). Transmit is
+* allowed only when line is silent and predicted quiet window before next
+* heartbeat fits frame airtime and expected answer. Learned burst is also kept
+* free when its heartbeat is late or lost.
+* Until period is learned only line silence is checked.
+*/
+class BusScheduler {
+  private:
+	uint32_t heartbeatPeriod;    // us, 0 not learned yet
+	uint32_t lastHeartbeat;      // us, heartbeat start
+	bool heartbeatSeen;
+	uint8_t periodMismatch;
+	uint32_t burstLength;    // us, from heartbeat start to end of master burst
+	uint32_t burstEnd;       // us, current cycle burst end
+	uint32_t txStart;
+	uint32_t txEnd;
+	uint8_t txLength;
+	bool txWindow;
+	uint32_t transmissions;
+	uint32_t collisions;
+	uint32_t retries;
+
+	void learnHeartbeat(uint32_t start);
+	bool inBurst(uint32_t now) const;
+	bool ownEcho(uint32_t startTime, uint8_t length) const;
+
+  public:
+	BusScheduler();
+
+	static uint32_t airtime(uint8_t length);
+	void frameReceived(FrameClassifier::FrameKind kind, uint32_t endTime, uint8_t length, bool crcValid);
+	bool clearToSend(uint32_t now, uint32_t idleTime, uint8_t length, uint8_t responseLength = 0);
+	void transmitted(uint32_t startTime, uint8_t length);
+	void retried();
+	uint32_t nextHeartbeat(uint32_t now) const;
+	uint32_t getHeartbeatPeriod() const;
+	uint32_t getBurstLength() const;
+	uint32_t getTransmissions() const;
+	uint32_t getCollisions() const;
+	uint32_t getRetries() const;
+};
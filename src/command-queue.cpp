@@ -0,0 +1,183 @@
+/*
+command-queue.cpp - Estia R32 heat pump commands queue
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "command-queue.hpp"
+
+// byte telling apart commands of the same data type, `0` none
+static uint8_t commandQualifier(const FrameView& frame, uint16_t dataType) {
+	switch (dataType) {
+	case FRAME_DATA_TYPE_MODE_CHANGE:
+		return frame[SET_MODE_CODE_OFFSET];
+
+	case FRAME_DATA_TYPE_OPERATION_SWITCH:
+		return frame[SWITCH_VALUE_OFFSET] < SWITCH_OPERATION_HOT_WATER ? SWITCH_OPERATION_COOL_HEAT : SWITCH_OPERATION_HOT_WATER;
+
+	case FRAME_DATA_TYPE_TEMPERATURE_CHANGE:
+		return frame[TEMPERATURE_CODE_OFFSET];
+
+	case FRAME_DATA_TYPE_SPECIAL_CMD:
+		return frame[FORCE_DEFROST_CODE_OFFSET];
+	}
+	return 0;
+}
+
+CommandQueue::CommandQueue()
+    : commands()
+    , count(0)
+    , locked(false)
+    , drops(0)
+    , replaced(0)
+    , dropHandler(nullptr) {
+}
+
+/** Default priority of command frame.
+*
+* Cooling/heating and hot water off and forced defrost are high, temperatures low, other normal.
+*/
+CommandQueue::Priority CommandQueue::priority(const EstiaFrame& frame) {
+	FrameView view(frame.data(), frame.size());
+	switch (EstiaFrame::readUint16(view, FRAME_DATA_TYPE_OFFSET)) {
+	case FRAME_DATA_TYPE_OPERATION_SWITCH:
+		return view[SWITCH_VALUE_OFFSET] == SWITCH_OPERATION_COOL_HEAT || view[SWITCH_VALUE_OFFSET] == SWITCH_OPERATION_HOT_WATER ? priority_high : priority_normal;
+
+	case FRAME_DATA_TYPE_SPECIAL_CMD:
+		return view[FORCE_DEFROST_CODE_OFFSET] == FORCE_DEFROST_CODE ? priority_high : priority_normal;
+
+	case FRAME_DATA_TYPE_TEMPERATURE_CHANGE:
+		return priority_low;
+	}
+	return priority_normal;
+}
+
+bool CommandQueue::push(const EstiaFrame& frame) {
+	return push(frame, priority(frame));
+}
+
+/** Queue command, replace pending command of the same kind.
+*
+* When queue is full newest pending command with lower priority is dropped,
+* otherwise new command is dropped.
+* @return false when command was dropped
+*/
+bool CommandQueue::push(const EstiaFrame& frame, Priority priority) {
+	FrameView view(frame.data(), frame.size());
+	Command command;
+	command.frame.assign(frame.data(), frame.data() + frame.size());
+	command.dataType = EstiaFrame::readUint16(view, FRAME_DATA_TYPE_OFFSET);
+	command.qualifier = commandQualifier(view, command.dataType);
+	command.priority = priority;
+
+	for (uint8_t idx = locked ? 1 : 0; idx < count; idx++) {
+		Command& pending = commands[idx];
+		if (pending.dataType != command.dataType || pending.qualifier != command.qualifier) { continue; }
+
+		replaced++;
+		if (pending.priority == priority) {
+			pending = command;    // keep queue position
+			return true;
+		}
+		erase(idx);
+		break;
+	}
+	if (count == CMD_QUEUE_SIZE) {
+		uint8_t last = count - 1;
+		if ((locked && last == 0) || commands[last].priority >= priority) {
+			drops++;
+			if (dropHandler) { dropHandler(command.dataType, drop_queue_full); }
+			return false;
+		}
+		drop(last, drop_evicted);
+	}
+	insert(command);
+	return true;
+}
+
+/** Next command to send, queue must not be empty. */
+const CommandQueue::Command& CommandQueue::front() const {
+	return commands[0];
+}
+
+// front command transmitted, it can not be replaced or moved
+void CommandQueue::lockFront() {
+	locked = count != 0;
+}
+
+// front command acknowledged
+void CommandQueue::pop() {
+	if (count == 0) { return; }
+
+	erase(0);
+	locked = false;
+}
+
+// front command not acknowledged after retries
+void CommandQueue::dropFront() {
+	if (count == 0) { return; }
+
+	drop(0, drop_no_ack);
+	locked = false;
+}
+
+/** @param handler `void(uint16_t dataType, DropReason reason)` */
+void CommandQueue::onDrop(DropHandler handler) {
+	dropHandler = handler;
+}
+
+bool CommandQueue::empty() const {
+	return count == 0;
+}
+
+size_t CommandQueue::size() const {
+	return count;
+}
+
+uint32_t CommandQueue::getDrops() const {
+	return drops;
+}
+
+// commands replaced by newer ones of the same kind before transmission
+uint32_t CommandQueue::getReplaced() const {
+	return replaced;
+}
+
+// after last command with same or higher priority, never before locked front
+void CommandQueue::insert(const Command& command) {
+	uint8_t pos = count;
+	while (pos > (locked ? 1 : 0) && commands[pos - 1].priority < command.priority) {
+		pos--;
+	}
+	for (uint8_t idx = count; idx > pos; idx--) {
+		commands[idx] = commands[idx - 1];
+	}
+	commands[pos] = command;
+	count++;
+}
+
+void CommandQueue::erase(uint8_t idx) {
+	for (; idx + 1 < count; idx++) {
+		commands[idx] = commands[idx + 1];
+	}
+	count--;
+}
+
+void CommandQueue::drop(uint8_t idx, DropReason reason) {
+	uint16_t dataType = commands[idx].dataType;
+	erase(idx);
+	drops++;
+	if (dropHandler) { dropHandler(dataType, reason); }
+}
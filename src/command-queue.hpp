@@ -0,0 +1,89 @@
+/*
+command-queue.hpp - Estia R32 heat pump commands queue
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "frames/commands-frames.hpp"
+#include <functional>
+
+#define CMD_QUEUE_SIZE 10
+
+/** Fixed size commands queue with coalescing and priorities.
+*
+* Command replaces pending (not transmitted) command of the same kind (data type and
+* zone/mode/operation), so repeated setpoint changes cost one ack round trip.
+* Higher priority commands are sent first, FIFO within priority. Front command is
+* locked once transmitted, until acknowledged or dropped. Dropped commands are
+* counted and reported to handler.
+*/
+class CommandQueue {
+  public:
+	enum Priority : uint8_t {
+		priority_low,       // temperature changes
+		priority_normal,    // modes, operation on
+		priority_high,      // operation off, forced defrost
+	};
+
+	enum DropReason : uint8_t {
+		drop_queue_full,    // new command, queue full of higher or equal priority commands
+		drop_evicted,       // pending lower priority command removed for new one
+		drop_no_ack,        // retries exhausted
+	};
+
+	/**
+	* @param frame command frame
+	* @param dataType frame data type, acknowledged by master
+	* @param qualifier zone/mode/operation code, same kind commands replace each other
+	*/
+	struct Command {
+		FrameBuffer frame;
+		uint16_t dataType;
+		uint8_t qualifier;
+		Priority priority;
+	};
+
+	using DropHandler = std::function<void(uint16_t dataType, DropReason reason)>;
+
+  private:
+	Command commands[CMD_QUEUE_SIZE];
+	uint8_t count;
+	bool locked;    // front command transmitted
+	uint32_t drops;
+	uint32_t replaced;
+	DropHandler dropHandler;
+
+	void insert(const Command& command);
+	void erase(uint8_t idx);
+	void drop(uint8_t idx, DropReason reason);
+
+  public:
+	CommandQueue();
+
+	static Priority priority(const EstiaFrame& frame);
+	bool push(const EstiaFrame& frame);
+	bool push(const EstiaFrame& frame, Priority priority);
+	const Command& front() const;
+	void lockFront();
+	void pop();
+	void dropFront();
+	void onDrop(DropHandler handler);
+	bool empty() const;
+	size_t size() const;
+	uint32_t getDrops() const;
+	uint32_t getReplaced() const;
+};
@@ -18,130 +18,251 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 
 #include "estia-serial.hpp"
 
-SoftwareSerial softwareSerial;
+// operation, compressors, heaters, pump or defrost state, sensors values will move when changed
+static constexpr uint32_t operationFields = (1UL << StatusChanges::field_operation_mode) |
+                                            (1UL << StatusChanges::field_cooling) |
+                                            (1UL << StatusChanges::field_heating) |
+                                            (1UL << StatusChanges::field_hot_water) |
+                                            (1UL << StatusChanges::field_cooling_cmp) |
+                                            (1UL << StatusChanges::field_heating_cmp) |
+                                            (1UL << StatusChanges::field_hot_water_cmp) |
+                                            (1UL << StatusChanges::field_backup_heater) |
+                                            (1UL << StatusChanges::field_hot_water_heater) |
+                                            (1UL << StatusChanges::field_pump1) |
+                                            (1UL << StatusChanges::field_defrost_in_progress);
+
+// handlers indexed by FrameClassifier::FrameKind
+const EstiaSerial::FrameHandler EstiaSerial::frameHandlers[FrameClassifier::frame_kinds_count] = {
+    nullptr,                           // frame_unknown
+    nullptr,                           // frame_heartbeat
+    &EstiaSerial::decodeStatus,        // frame_status
+    nullptr,                           // frame_short_status
+    &EstiaSerial::decodeStatus,        // frame_status_update
+    nullptr,                           // frame_remote_status
+    &EstiaSerial::decodeRequest,       // frame_data_request
+    &EstiaSerial::decodeResponse,      // frame_data_response
+    &EstiaSerial::decodeAck,           // frame_ack
+};
 
 SensorData::SensorData(int16_t value, const float multiplier)
     : value(value)
     , multiplier(multiplier) {
 }
 
+QueuedRequest::QueuedRequest(uint8_t code, RequestCallback callback, bool polled)
+    : code(code)
+    , callback(callback)
+    , polled(polled) {
+}
+
+#ifdef ESTIA_TRANSPORT_SOFTWARE_SERIAL
 EstiaSerial::EstiaSerial(uint8_t rxPin, uint8_t txPin)
-    : serial(&softwareSerial)
-    , rxPin(rxPin)
-    , txPin(txPin)
-    , newSensorsData(false)
+    : EstiaSerial(softwareSerialTransport) {
+	softwareSerialTransport.setPins(rxPin, txPin);
+}
+#endif
+
+EstiaSerial::EstiaSerial(Transport& transport)
+    : sensors()
+    , pollScheduler()
+    , history()
+    , aggregator()
+    , sensorsData()
     , requestSent(false)
     , requestQueue()
     , requestTimer(0)
     , requestRetry(0)
+    , responseWaiting(false)
+    , responseValue(0)
+    , passiveCode(0)
+    , passiveTimer(0)
+    , passivePending(false)
+    , statusTemperatures(false)
     , snifferBuffer()
-    , sniffedFrame()
+    , snifferTimes()
+    , rxTimestamp(0)
+    , lastReadTime(0)
+    , lastReceiveTime(0)
+    , frameAssembler()
+    , busScheduler()
     , sniffedFrames()
-    , frameAck(0)
-    , newStatusData(false)
     , statusData()
+    , statusChanges()
+    , statusReceived(false)
+    , packedStatus()
     , cmdSent(false)
     , cmdQueue()
     , cmdTimer(0)
     , cmdRetry(0)
+    , transport(&transport)
     , frameFixer()
-    , sensorsData() {
+    , statusHandler(nullptr)
+    , statusChangeHandler(nullptr)
+    , ackHandler(nullptr)
+    , sensorHandler(nullptr)
+    , sweepHandler(nullptr)
+    , rawFrameHandler(nullptr)
+    , frameAck(0)
+    , newStatusData(false)
+    , newSensorsData(false) {
+	setIdleGap(ESTIA_SERIAL_IDLE_GAP);
+	frameAssembler.setExactTimes(false);    // transport gives no receive times, bytes are stamped at read
+	frameAssembler.onFrame([this](FrameBuffer& frame, FrameView::CrcState crc) { this->decodeFrame(frame, crc); });
 }
 
-void EstiaSerial::begin() {
-	serial->begin(ESTIA_SERIAL_BAUD, ESTIA_SERIAL_CONFIG, rxPin, txPin);
-	serial->enableIntTx(false);    //disable TX
+bool EstiaSerial::begin() {
+	if (!sniffedFrames.allocate(SNIFFED_FRAMES_LIMIT)) { return false; }    // all frame slots allocated once
+	if (!transport->begin()) { return false; }
+
+	// first received bytes are not older than begin()
+	lastReadTime = transport->timestamp();
+	rxTimestamp = lastReadTime;
+	lastReceiveTime = lastReadTime;
+	return true;
 }
 
 EstiaSerial::SnifferState EstiaSerial::sniffer() {
-	static u_long readTimer = 0;
-	bool timeout = !snifferBuffer.empty() && millis() - readTimer >= ESTIA_SERIAL_READ_TIMEOUT;
-	if (serial->available() >= ESTIA_SERIAL_MIN_AVAILABLE || timeout) {
-		bool newFrame = this->read(snifferBuffer);
-		readTimer = millis();
-		if (this->splitSnifferBuffer(newFrame || timeout)) {
-			for (auto& frame : sniffedFrames) {
-				frameFixer.fixFrame(frame);
-				if (EstiaFrame::readUint16(frame, 0) != FRAME_BEGIN) { continue; }
-				if (decodeStatus(frame)) { continue; }
-				if (decodeAck(frame)) { continue; }
-				decodeResponse(frame);
-			}
-		}
-	}
+	this->read(snifferBuffer, snifferTimes);
+	this->assembleFrames();    // frames are decoded by decodeFrame() as they are completed
+	this->releaseHandledFrames();
+	aggregator.tick(millis());
+
 	if (!sniffedFrames.empty()) { return sniff_frame_pending; }
-	if (!snifferBuffer.empty() || serial->available()) { return sniff_busy; }
+	if (frameAssembler.busy() || !snifferBuffer.empty() || transport->available()) { return sniff_busy; }
 	if (sendCommand()) { return sniff_busy; }
 	if (sendRequest()) { return sniff_busy; }
 	return sniff_idle;
 }
 
-FrameBuffer EstiaSerial::getSniffedFrame() {
-	FrameBuffer frame;
-	if (!sniffedFrames.empty()) {
-		frame = sniffedFrames.front();
-		sniffedFrames.pop_front();
-	}
-	return frame;
+/** Move oldest sniffed frame out of queue, no copy.
+*
+* Frame slot returns to pool when handle is destroyed or released,
+* invalid (empty) handle when there is no frame.
+*/
+FrameHandle EstiaSerial::getSniffedFrame() {
+	return sniffedFrames.take();
 }
 
-bool EstiaSerial::decodeStatus(FrameBuffer& buffer) {
-	if (!(EstiaFrame::isStatusFrame(buffer) || EstiaFrame::isStatusUpdateFrame(buffer))) { return false; }
-
+/** Decode status and notify only about changed fields.
+*
+* Frame is merged into packed status (raw bytes), fields are decoded and compared
+* one by one only when packed status differs from previous one.
+*/
+bool EstiaSerial::decodeStatus(const FrameView& buffer) {
 	StatusFrame statusFrame(buffer, buffer.size());
-	if (statusFrame.error == StatusFrame::err_ok) {
-		statusData = statusFrame.decode();
-		newStatusData = true;
+	if (statusFrame.error != StatusFrame::err_ok) { return true; }
+
+	bool longFrame = buffer.size() == FRAME_STATUS_LEN;
+	PackedStatus previous = packedStatus;
+	packedStatus.merge(statusFrame.pack());
+	if (statusReceived && packedStatus == previous) {
+		if (longFrame) { saveStatusTemperatures(); }
+		return true;
 	}
+	StatusData previousData = statusData;
+	statusData = packedStatus.unpack();
+	StatusChanges changes = statusReceived ? StatusChanges::compare(previousData, statusData) : StatusChanges::all();
+	statusReceived = true;
+	if (changes.any(operationFields)) { pollScheduler.wake(); }
+	if (longFrame) { saveStatusTemperatures(); }
+	aggregator.status(statusData, millis());
+	if (changes.empty()) { return true; }
+
+	if (!newStatusData) { statusChanges = StatusChanges(); }
+	statusChanges |= changes;
+	newStatusData = true;
+	if (statusHandler) { statusHandler(statusData); }
+	if (statusChangeHandler) { statusChangeHandler(statusData, changes); }
 	return true;
 }
 
+void EstiaSerial::saveStatusTemperatures() {
+	if (!statusTemperatures) { return; }
+
+	observeSensorData(CODE_TWO, statusData.waterOutletTemperature, STATUS_TEMPERATURE_MAX_AGE);
+	observeSensorData(CODE_TWI, statusData.waterInletTemperature, STATUS_TEMPERATURE_MAX_AGE);
+}
+
 StatusData& EstiaSerial::getStatusData() {
 	newStatusData = false;
 	return statusData;
 }
 
+/** Fields changed since status data was read (`getStatusData()`), valid until next change.
+*
+* `for (StatusChanges::Field field : estiaSerial.getStatusChanges())` iterates changed fields only.
+*/
+StatusChanges EstiaSerial::getStatusChanges() {
+	return statusChanges;
+}
+
+/** Current status as raw bytes (14 Bytes), for cheap snapshots and comparison. */
+const PackedStatus& EstiaSerial::getPackedStatus() {
+	return packedStatus;
+}
+
+/** String keyed copy of sensors data, kept for compatibility.
+*
+* Map is rebuilt from `SensorStore` on every call, use `getSensors()` to avoid allocations.
+*/
 EstiaData& EstiaSerial::getSensorsData() {
 	newSensorsData = false;
+	sensorsData.clear();
+	for (SensorStore::Reading sensor : sensors) {
+		sensorsData.emplace(sensor.descriptor.name, SensorData(sensor.value, sensor.descriptor.multiplier));
+	}
 	return sensorsData;
 }
 
-bool EstiaSerial::decodeAck(FrameBuffer& buffer) {
-	if (!EstiaFrame::isAckFrame(buffer)) { return false; }
+const SensorStore& EstiaSerial::getSensors() {
+	newSensorsData = false;
+	return sensors;
+}
 
+bool EstiaSerial::decodeAck(const FrameView& buffer) {
 	AckFrame ackFrame(buffer);
 	if (ackFrame.error != StatusFrame::err_ok) { return true; }
 
 	frameAck = ackFrame.frameCode;
+	if (ackHandler) { ackHandler(ackFrame.frameCode); }
 
 	// command received, remove from queue
 	if (cmdSent && ackFrame.frameCode == cmdQueue.front().dataType) {
-		cmdQueue.pop_front();
+		cmdQueue.pop();
 		cmdRetry = 0;
 		cmdSent = false;
 	}
 	return true;
 }
 
-void EstiaSerial::queueCommand(EstiaFrame& command) {
-	if (cmdQueue.size() >= CMD_QUEUE_SIZE) { return; }
+// replaces pending command of the same kind, drops are reported by `onCommandDrop()`
+void EstiaSerial::queueCommand(const EstiaFrame& command) {
+	cmdQueue.push(command);
+}
 
-	cmdQueue.push_back(command);
+// pre-encoded command (flash), bytes are copied, no frame building
+void EstiaSerial::queueCommand(const CommandFrame& command) {
+	cmdQueue.push(EstiaFrame(command));
 }
 
 bool EstiaSerial::sendCommand() {
 	// clear flag to resend command
 	if (cmdSent && millis() - cmdTimer > CMD_TIMEOUT) {
 		cmdRetry++;
+		busScheduler.retried();
 		if (cmdRetry > CMD_RETRIES) {
-			cmdQueue.pop_front();
+			cmdQueue.dropFront();
 			cmdRetry = 0;
 		}
 		cmdSent = false;
 	}
 	if (!cmdSent && !cmdQueue.empty()) {
+		const FrameBuffer& command = cmdQueue.front().frame;
+		if (!this->clearToSend(command.size(), FRAME_ACK_LEN)) { return false; }
+
 		cmdSent = true;
-		this->write(cmdQueue.front(), false);
+		cmdQueue.lockFront();
+		this->write(command, false);
 		cmdTimer = millis();
 		return true;
 	}
@@ -154,162 +275,457 @@ uint16_t EstiaSerial::getAck() {
 	return acked;
 }
 
+uint32_t EstiaSerial::getRxOverflows() {
+	return snifferBuffer.overflows();
+}
+
+// sniffed frames overwritten or dropped (no free slot)
+uint32_t EstiaSerial::getFrameDrops() {
+	return sniffedFrames.drops();
+}
+
+const BusScheduler& EstiaSerial::getBusScheduler() {
+	return busScheduler;
+}
+
+/** @param charTimes line silence closing frame, in character times (4.58 ms at 2400 8E1) */
+void EstiaSerial::setIdleGap(float charTimes) {
+	frameAssembler.setIdleGap(charTimes * ESTIA_SERIAL_CHAR_TIME);
+}
+
 bool EstiaSerial::sendRequest() {
+	if (requestQueue.empty()) { this->queuePoll(); }
 	if (requestQueue.empty()) { return false; }
 
-	// discard invalid requests
-	while (requestsMap.count(requestQueue.front()) == 0) {
-		requestQueue.pop_front();
-		if (requestQueue.empty()) { break; }
-	}
 	// request timeout
-	if (requestSent && !requestQueue.empty() && millis() - requestTimer >= (requestRetry + 1) * REQUEST_TIMEOUT) {
+	if (requestSent && millis() - requestTimer >= (requestRetry + 1U) * REQUEST_TIMEOUT) {
 		requestRetry++;
+		busScheduler.retried();
 		if (requestRetry > REQUEST_RETRIES) {
-			saveSensorData(err_timeout);
-			requestQueue.pop_front();
-			requestRetry = 0;
+			completeRequest(err_timeout);
 		}
 		requestSent = false;
 	}
-	// last queue element was popped
-	if (requestQueue.empty()) {
-		newSensorsData = true;
-	}
-	if (!requestSent && !requestQueue.empty() && !cmdSent && millis() - requestTimer >= REQUEST_DELAY) {
-		this->write(DataReqFrame(requestsMap.at(requestQueue.front()).code));
+	// commands go first
+	if (!requestSent && !requestQueue.empty() && cmdQueue.empty() && millis() - requestTimer >= REQUEST_DELAY) {
+		if (!this->clearToSend(FRAME_REQ_DATA_LEN, FRAME_RES_DATA_LEN)) { return false; }
+
+		this->write(DataReqFrame(requestQueue.front().code));
 		requestTimer = millis();
 		requestSent = true;
+		pollScheduler.requested();
+		if (requestQueue.front().polled) { pollScheduler.sent(requestQueue.front().code, requestTimer); }
 		return true;
 	}
 	return false;
 }
 
-bool EstiaSerial::decodeResponse(FrameBuffer& buffer) {
-	if (!EstiaFrame::isDataResFrame(buffer)) { return false; }
-	if (requestQueue.empty()) { return true; }
+// own requests are not received (RX disabled while sending), sniffed request comes from other device
+bool EstiaSerial::decodeRequest(const FrameView& buffer) {
+	if (buffer.crc() != FrameView::crc_valid || buffer.size() != FRAME_REQ_DATA_LEN) { return true; }
+
+	passiveCode = buffer[REQ_DATA_CODE_OFFSET];
+	passiveTimer = millis();
+	passivePending = true;
+	return true;
+}
+
+bool EstiaSerial::decodeResponse(const FrameView& buffer) {
+	if (passiveResponse()) {
+		decodePassive(buffer);
+		return true;
+	}
+	if (!requestSent) { return true; }    // response to other device request, ours is still queued
 
 	requestTimer = millis();
 	DataResFrame resFrame(buffer);
 	if (resFrame.error != DataResFrame::err_ok) {
 		resFrame.value = err_timeout + -resFrame.error;
 		requestRetry++;
+		busScheduler.retried();
 		if (requestRetry <= REQUEST_RETRIES) {
 			requestSent = false;
 			return true;
 		}
 	}
 
-	saveSensorData(resFrame.value);
+	completeRequest(resFrame.value);
+	return true;
+}
 
-	// remove request from queue
+// response belongs to latest request on the bus, sniffed one when it came after ours
+bool EstiaSerial::passiveResponse() {
+	if (!passivePending) { return false; }
+	if (millis() - passiveTimer > REQUEST_TIMEOUT) {
+		passivePending = false;
+		return false;
+	}
+	return !requestSent || static_cast<int32_t>(passiveTimer - requestTimer) >= 0;
+}
+
+// value requested by other device, saved with passive marker, errors are ignored
+void EstiaSerial::decodePassive(const FrameView& buffer) {
+	passivePending = false;
+	DataResFrame resFrame(buffer);
+	if (resFrame.error != DataResFrame::err_ok) { return; }
+
+	observeSensorData(passiveCode, resFrame.value, pollScheduler.getPassiveMaxAge());
+}
+
+// value received without own request, saved with passive marker
+void EstiaSerial::observeSensorData(uint8_t code, int16_t value, uint32_t maxAge) {
+	saveSensorData(code, value, true);
+	pollScheduler.observed(code, millis(), maxAge);
+	pollScheduler.received(code, value);
+	if (sensorHandler) { sensorHandler(code, value); }
+}
+
+// remove request from queue and report value (or error code)
+void EstiaSerial::completeRequest(int16_t value) {
+	QueuedRequest request = std::move(requestQueue.front());
 	requestQueue.pop_front();
 	requestRetry = 0;
 	requestSent = false;
+	if (request.polled) { pollScheduler.finished(request.code); }
 
-	if (requestQueue.empty()) {
+	if (!request.callback) {
+		saveSensorData(request.code, value);
+		if (value > err_not_exist) { pollScheduler.received(request.code, value); }
+	}
+	if (sensorHandler) { sensorHandler(request.code, value); }
+	if (request.callback) {
+		request.callback(value);
+		return;
+	}
+	if (request.polled) { return; }
+	if (!sensorsRequestPending()) {
 		newSensorsData = true;
+		if (sweepHandler) { sweepHandler(sensors); }
 	}
-	return true;
 }
 
-void EstiaSerial::saveSensorData(uint16_t data) {
-	if (sensorsData.count(requestQueue.front()) == 1) {
-		sensorsData.at(requestQueue.front()).value = data;
-	} else {
-		sensorsData.emplace(requestQueue.front(), SensorData(data, requestsMap.at(requestQueue.front()).multiplier));
+bool EstiaSerial::sensorsRequestPending() {
+	for (auto& request : requestQueue) {
+		if (!request.callback && !request.polled) { return true; }
 	}
+	return false;
 }
 
-bool EstiaSerial::splitSnifferBuffer(bool ignoreMinLen) {
-	if (!ignoreMinLen && snifferBuffer.size() < FRAME_MIN_LEN) { return false; }
+// periodic sensors are requested only when there is no other request queued
+void EstiaSerial::queuePoll() {
+	uint8_t requestCode = pollScheduler.next(millis());
+	if (requestCode == SENSOR_NONE) { return; }
 
-	uint8_t frameSize = 0;
-	while (!snifferBuffer.empty()) {
-		// calculate expected frame length from data
-		if (frameSize == 0 && sniffedFrame.size() >= FRAME_HEAD_LEN
-		    && EstiaFrame::readUint16(sniffedFrame, 0) == FRAME_BEGIN) {
-			frameSize = sniffedFrame.at(FRAME_DATA_LEN_OFFSET) + FRAME_HEAD_AND_CRC_LEN;
-		}
-		// next frame begin detected in sniffer buffer
-		if (!sniffedFrame.empty() && EstiaFrame::readUint16(snifferBuffer, 0) == FRAME_BEGIN) {
-			// frame shorter than expected and shorter than max
-			if (sniffedFrame.size() < frameSize && frameSize <= FRAME_MAX_LEN
-			    && sniffedFrame.size() <= FRAME_MAX_LEN) {
-				// read remaining data
-				this->read(snifferBuffer);
-				// push 0xa0 byte to current frame
-				sniffedFrame.push_back(snifferBuffer.front());
-				snifferBuffer.pop_front();
-				// and continue
-				continue;
-			}
-			// next frame has already begun in sniffer buffer
-			break;
-		}
-		// check for joined two frames (first probably malformed)
-		if (frameSize != 0 && sniffedFrame.size() > frameSize) {
-			// check sniffed frame for next frame begin byte (skip first byte)
-			for (uint8_t idx = 1; idx < sniffedFrame.size(); idx++) {
-				if (EstiaFrame::readUint16(sniffedFrame, idx) == FRAME_BEGIN) {
-					FrameBuffer firstFrame(sniffedFrame.begin(), sniffedFrame.begin() + idx);
-					sniffedFrame.erase(sniffedFrame.begin(), sniffedFrame.begin() + idx);
-					sniffedFrames.push_back(firstFrame);
-					frameSize = 0;
-					break;
-				}
-			}
-		}
-		sniffedFrame.push_back(snifferBuffer.front());
-		snifferBuffer.pop_front();
+	requestQueue.emplace_back(requestCode, nullptr, true);
+}
+
+void EstiaSerial::saveSensorData(uint8_t code, int16_t data, bool passive) {
+	uint32_t now = millis();
+	sensors.set(code, data, now, data <= err_not_exist, passive);
+	if (data > err_not_exist) {
+		history.append(code, now, data);
+		aggregator.sample(code, data, now);
 	}
-	sniffedFrames.push_back(sniffedFrame);
-	while (sniffedFrames.size() >= SNIFFED_FRAMES_LIMIT) {
-		sniffedFrames.pop_front();
+}
+
+/** Split received bytes into frames.
+*
+* @return number of frames queued in `sniffedFrames`
+*/
+size_t EstiaSerial::assembleFrames() {
+	size_t received = 0;
+	const uint8_t* data;
+	const uint32_t* times;
+	size_t len;
+	while ((len = snifferBuffer.peek(data)) != 0) {
+		snifferTimes.peek(times);    // filled in step with bytes, same span
+		received += frameAssembler.push(data, times, len, sniffedFrames);
+		snifferBuffer.consume(len);
+		snifferTimes.consume(len);
 	}
-	sniffedFrame.clear();
+	// line idle, close frame
+	received += frameAssembler.idle(transport->timestamp() - lastReceiveTime, sniffedFrames);
+	return received;
+}
 
+// called by assembler before frame is queued, decoding does not depend on free frame slots
+void EstiaSerial::decodeFrame(FrameBuffer& frame, FrameView::CrcState crc) {
+	FrameView view = this->checkFrame(frame, crc);
+	FrameClassifier::FrameKind kind = this->frameReceived(view);
+	if (kind == FrameClassifier::frame_data_response && responseWaiting) {
+		DataResFrame response(view);
+		responseWaiting = false;
+		responseValue = response.error == DataResFrame::err_ok ? response.value : err_timeout + -response.error;
+		return;
+	}
+	FrameHandler handler = frameHandlers[kind];
+	if (handler) { (this->*handler)(view); }
+}
+
+// CRC checked once by assembler, fixer runs only for bad frames, decoders use view without copy
+FrameView EstiaSerial::checkFrame(FrameBuffer& frame, FrameView::CrcState crc) {
+	if (crc == FrameView::crc_valid) { return FrameView(frame, crc); }
+
+	return FrameView(frame, frameFixer.fixFrame(frame, crc) ? FrameView::crc_valid : FrameView::crc_invalid);
+}
+
+// classify, pass frame timing to transmit scheduler and raw frame to handler
+FrameClassifier::FrameKind EstiaSerial::frameReceived(const FrameView& view) {
+	FrameClassifier::FrameKind kind = FrameClassifier::classify(view);
+	busScheduler.frameReceived(kind, frameAssembler.getFrameEndTime(), view.size(), view.crc() == FrameView::crc_valid);
+	if (rawFrameHandler) { rawFrameHandler(view); }
+	return kind;
+}
+
+bool EstiaSerial::clearToSend(uint8_t length, uint8_t responseLength) {
+	uint32_t now = transport->timestamp();
+	if (!busScheduler.clearToSend(now, now - lastReceiveTime, length, responseLength)) { return false; }
+
+	busScheduler.transmitted(now, length);
 	return true;
 }
 
+void EstiaSerial::releaseHandledFrames() {
+	// frames already passed to handler
+	if (rawFrameHandler) {
+		sniffedFrames.clear();
+	}
+}
+
 int16_t EstiaSerial::requestData(uint8_t requestCode) {
 	DataReqFrame request(requestCode);
+	busScheduler.transmitted(transport->timestamp(), request.size());
+	pollScheduler.requested();
 	this->write(request);    //send request
 	uint32_t responseTimeoutTimer = millis();
-	while (!serial->available()) {    // wait for response
-		if (millis() - responseTimeoutTimer > REQUEST_TIMEOUT) { return err_timeout; }
+	responseWaiting = true;    // response is taken by decodeFrame()
+	while (millis() - responseTimeoutTimer <= REQUEST_TIMEOUT) {    // wait for response
+		this->read(snifferBuffer, snifferTimes);
+		this->assembleFrames();
+		this->releaseHandledFrames();
+		if (!responseWaiting) { return responseValue; }
 		delay(ESTIA_SERIAL_BYTE_DELAY);
 	}
-	delay(ESTIA_SERIAL_BYTE_DELAY * 2);    // 2 bytes head start
-	splitSnifferBuffer();                  // read out data in buffer
-	snifferBuffer.clear();
-	this->read(snifferBuffer);
-	DataResFrame response(snifferBuffer);
-	if (response.error != DataResFrame::err_ok) { return err_timeout + -response.error; }
-	return response.value;
+	responseWaiting = false;
+	return err_timeout;
 }
 
 int16_t EstiaSerial::requestData(std::string request) {
-	if (requestsMap.count(request) == 1) {
-		return requestData((requestsMap.at(request)).code);
+	uint8_t requestCode;
+	if (requestsMap.find(request.c_str(), requestCode)) {
+		return requestData(requestCode);
 	}
 	return err_not_exist;
 }
 
+/** Queue single data request, does not wait for response.
+*
+* Request is sent by `sniffer()` and callback is called from `sniffer()`
+* with value or error code (`ResponseError`).
+* @param requestCode data code
+* @param callback `void(int16_t value)`
+*/
+bool EstiaSerial::requestDataAsync(uint8_t requestCode, RequestCallback callback) {
+	if (!callback) { return false; }
+
+	requestQueue.emplace_back(requestCode, callback);
+	return true;
+}
+
+bool EstiaSerial::requestDataAsync(std::string request, RequestCallback callback) {
+	uint8_t requestCode;
+	if (!requestsMap.find(request.c_str(), requestCode)) { return false; }
+
+	return requestDataAsync(requestCode, callback);
+}
+
+/** Request sensor data periodically, result is saved to sensors data (`getSensors()`).
+*
+* Due requests are sent by `sniffer()` when there is no other request pending,
+* higher priority first. Lateness of every request is available from `getPollScheduler()`.
+* @param requestCode data code
+* @param period ms, `0` stops polling
+* @param priority `priority_low` `priority_normal` `priority_high`
+*/
+bool EstiaSerial::pollSensor(uint8_t requestCode, uint32_t period, PollScheduler::Priority priority) {
+	return pollScheduler.setPeriod(requestCode, period, priority, millis());
+}
+
+bool EstiaSerial::pollSensor(std::string request, uint32_t period, PollScheduler::Priority priority) {
+	uint8_t requestCode;
+	if (!requestsMap.find(request.c_str(), requestCode)) { return false; }
+
+	return pollSensor(requestCode, period, priority);
+}
+
+const PollScheduler& EstiaSerial::getPollScheduler() {
+	return pollScheduler;
+}
+
+/** Back off stable sensors.
+*
+* Every unchanged value doubles sensor polling interval (or number of sweeps it is skipped)
+* up to `period << maxBackoff`. Changed value or operation, compressor, heater, pump
+* or defrost state change in status frame restores base rate.
+* @param enable `true` `false`
+* @param maxBackoff interval ceiling, `POLL_ADAPTIVE_MAX_BACKOFF` (x8)
+*/
+void EstiaSerial::setAdaptivePolling(bool enable, uint8_t maxBackoff) {
+	pollScheduler.setAdaptive(enable, maxBackoff);
+}
+
+/** Use sensors values requested by other devices (remote controller).
+*
+* Responses to sniffed data requests are always saved (`Reading.passive`), polled sensor
+* is due one interval after its value was observed, `requestSensorsData()` skips sensors
+* observed within `maxAge`.
+* @param maxAge ms, `POLL_PASSIVE_MAX_AGE` by default, `0` always request own values
+*/
+void EstiaSerial::setPassiveMaxAge(uint32_t maxAge) {
+	pollScheduler.setPassiveMaxAge(maxAge);
+}
+
+/** Fill TWO/TWI from long status frame (every 30 s) instead of requesting them.
+*
+* Values are saved as passive, `requestSensorsData()` skips them for `STATUS_TEMPERATURE_MAX_AGE`
+* and polled TWO/TWI are due one interval after status frame.
+* @param enable `true` `false`
+*/
+void EstiaSerial::setStatusTemperatures(bool enable) {
+	statusTemperatures = enable;
+}
+
+/** @return data requests transmitted per minute (all kinds, with retries) */
+float EstiaSerial::getRequestRate() {
+	return pollScheduler.getRequestRate(millis());
+}
+
+/** Keep history of sensor values (polled or requested by `requestSensorsData()`).
+*
+* Samples are delta encoded, ~1 Byte per sample for regular polling of slowly changing value,
+* oldest samples are dropped when ring is full. Ring is allocated once,
+* up to `HISTORY_SENSORS_LIMIT` sensors and `HISTORY_MEMORY_BUDGET` Bytes together.
+* @param requestCode data code
+* @param bytes ring size
+*/
+bool EstiaSerial::trackHistory(uint8_t requestCode, size_t bytes) {
+	return history.track(requestCode, bytes);
+}
+
+bool EstiaSerial::trackHistory(std::string request, size_t bytes) {
+	uint8_t requestCode;
+	if (!requestsMap.find(request.c_str(), requestCode)) { return false; }
+
+	return trackHistory(requestCode, bytes);
+}
+
+/** @return `nullptr` for sensor without history */
+const HistoryRing* EstiaSerial::getHistory(uint8_t requestCode) {
+	return history.ring(requestCode);
+}
+
+/** Aggregate sensors values and status flags in tumbling windows.
+*
+* Every window keeps min/max/mean/last of sensors values and on-time of compressors,
+* heaters, pump1 and defrost, closed window is passed to `onWindow()` handler.
+* @param length window length (ms), `0` disables aggregation
+*/
+void EstiaSerial::setAggregationWindow(uint32_t length) {
+	aggregator.begin(length, millis());
+}
+
+/** Called from `sniffer()` when aggregation window is closed.
+*
+* @param handler `void(const WindowRecord& window)`, `window.pack()` writes compact record
+*/
+void EstiaSerial::onWindow(WindowHandler handler) {
+	aggregator.onWindow(handler);
+}
+
+/** Called from `sniffer()` when status frame changed status data.
+*
+* @param handler `void(const StatusData& data)`, `nullptr` to remove
+*/
+void EstiaSerial::onStatus(StatusHandler handler) {
+	statusHandler = handler;
+}
+
+/** Called from `sniffer()` when status frame changed status data.
+*
+* @param handler `void(const StatusData& data, StatusChanges changes)`, changes of this frame only
+*/
+void EstiaSerial::onStatusChange(StatusChangeHandler handler) {
+	statusChangeHandler = handler;
+}
+
+/** Called from `sniffer()` when command is acknowledged.
+*
+* @param handler `void(uint16_t frameCode)`
+*/
+void EstiaSerial::onAck(AckHandler handler) {
+	ackHandler = handler;
+}
+
+/** Called from `sniffer()` for every data request result and value requested by other device.
+*
+* @param handler `void(uint8_t code, int16_t value)`, value below `err_not_exist` is error code
+*/
+void EstiaSerial::onSensor(SensorHandler handler) {
+	sensorHandler = handler;
+}
+
+/** Called from `sniffer()` when all sensors data requested by `requestSensorsData()` is received.
+*
+* @param handler `void(const SensorStore& sensors)`
+*/
+void EstiaSerial::onSweepComplete(SweepHandler handler) {
+	sweepHandler = handler;
+}
+
+/** Called from `sniffer()` for every sniffed frame (after CRC check and fixing).
+*
+* With handler set frames are not queued for `getSniffedFrame()`.
+* @param handler `void(const FrameView& frame)`, view is valid only during call
+*/
+void EstiaSerial::onRawFrame(RawFrameHandler handler) {
+	rawFrameHandler = handler;
+}
+
+/** Called when queued command is dropped (queue full, evicted by higher priority or not acknowledged).
+*
+* @param handler `void(uint16_t dataType, CommandQueue::DropReason reason)`
+*/
+void EstiaSerial::onCommandDrop(CommandQueue::DropHandler handler) {
+	cmdQueue.onDrop(handler);
+}
+
+// drops and replaced (coalesced) commands counters
+const CommandQueue& EstiaSerial::getCommandQueue() {
+	return cmdQueue;
+}
+
 void EstiaSerial::clearSensorsData() {
-	sensorsData.clear();
+	sensors.clear();
 }
 
 bool EstiaSerial::requestSensorsData(DataToRequest&& sensorsToRequest, bool clear) {
-	if (!requestQueue.empty()) { return false; }    // request in progress
+	if (sensorsRequestPending()) { return false; }    // request in progress
 
 	newSensorsData = false;
 	if (clear) { clearSensorsData(); }
 	for (auto& sensor : sensorsToRequest) {
-		if (requestsMap.count(sensor) == 0) {
+		uint8_t requestCode;
+		if (!requestsMap.find(sensor.c_str(), requestCode)) {
 			continue;
 		}
-		requestQueue.push_back(sensor);
+		if (!clear && pollScheduler.fresh(requestCode, millis())) { continue; }    // observed in remote controller traffic
+		if (!pollScheduler.sweep(requestCode)) { continue; }    // stable sensor (adaptive polling)
+		requestQueue.emplace_back(requestCode);
+	}
+	// all sensors skipped, stored values are current
+	if (!sensorsRequestPending()) {
+		newSensorsData = true;
+		if (sweepHandler) { sweepHandler(sensors); }
 	}
 	return true;
 }
@@ -323,7 +739,13 @@ bool EstiaSerial::requestSensorsData(DataToRequest& sensorsToRequest, bool clear
 * @param onOff `1` `0`
 */
 void EstiaSerial::modeSwitch(std::string mode, uint8_t onOff) {
-	if (modeByName.count(mode) == 0) { return; }
+	uint8_t modeCode;
+	if (!modeByName.find(mode.c_str(), modeCode)) { return; }
+	const CommandFrame* command = CommandTable::setMode(modeCode, onOff);
+	if (command) {
+		this->queueCommand(*command);
+		return;
+	}
 	SetModeFrame modeFrame(mode, onOff);
 	this->queueCommand(modeFrame);
 }
@@ -332,10 +754,10 @@ void EstiaSerial::modeSwitch(std::string mode, uint8_t onOff) {
 * @param mode `cooling` `heating`
 */
 void EstiaSerial::setOperationMode(std::string mode) {
-	if (operationModeByName.count(mode) == 0) { return; }
+	uint8_t modeCode;
+	if (!operationModeByName.find(mode.c_str(), modeCode)) { return; }
 
-	OperationMode operationMode(mode);
-	this->queueCommand(operationMode);
+	this->queueCommand(*CommandTable::operationMode(modeCode));
 }
 
 /**
@@ -343,12 +765,19 @@ void EstiaSerial::setOperationMode(std::string mode) {
 * @param onOff `1` `0`
 */
 void EstiaSerial::operationSwitch(std::string operation, uint8_t onOff) {
-	if (switchOperationByName.count(operation) == 0) { return; }
+	uint8_t operationCode;
+	if (!switchOperationByName.find(operation.c_str(), operationCode)) { return; }
 
 	// set operation mode (for cooling and heating)
-	if (operationModeByName.count(operation) != 0 && statusData.operationMode != operationModeByName.at(operation)) {
+	uint8_t modeCode;
+	if (operationModeByName.find(operation.c_str(), modeCode) && statusData.operationMode != modeCode) {
 		setOperationMode(operation);
 	}
+	const CommandFrame* command = CommandTable::switchOperation(operationCode, onOff);
+	if (command) {
+		this->queueCommand(*command);
+		return;
+	}
 	SwitchFrame switchFrame(operation, onOff);
 	this->queueCommand(switchFrame);
 }
@@ -367,11 +796,17 @@ void EstiaSerial::setMode(std::string mode, uint8_t onOff) {
 * @param temperature for cooling `7-25`, for heating `20-65`, for hot water `40-75`
 */
 void EstiaSerial::setTemperature(std::string zone, uint8_t temperature) {
-	if (temperatureByName.count(zone) == 0) { return; }
+	uint8_t zoneCode;
+	if (!temperatureByName.find(zone.c_str(), zoneCode)) { return; }
+	if (zoneCode == TEMPERATURE_HOT_WATER_CODE) {
+		this->queueCommand(*CommandTable::hotWaterTemperature(temperature));
+		return;
+	}
 	uint8_t zone1 = statusData.zone1Target;
 	uint8_t zone2 = statusData.zone2Target;
 	uint8_t hotWater = statusData.hotWaterTarget;
-	switch (temperatureByName.at(zone)) {
+	// hot water frame is pre-encoded, cooling/heating frames carry current targets
+	switch (zoneCode) {
 	case TEMPERATURE_COOLING_CODE:
 		zone1 = temperature;
 		zone2 = temperature;
@@ -380,13 +815,8 @@ void EstiaSerial::setTemperature(std::string zone, uint8_t temperature) {
 	case TEMPERATURE_HEATING_CODE:
 		zone1 = temperature;
 		break;
-
-	case TEMPERATURE_HOT_WATER_CODE:
-		hotWater = temperature;
-		break;
 	}
-	TemperatureFrame temperatureFrame(temperatureByName.at(zone), zone1, zone2, hotWater);
-	this->queueCommand(temperatureFrame);
+	this->queueCommand(TemperatureFrame::build(zoneCode, zone1, zone2, hotWater));
 }
 
 /** Force defrost on next operation start (heating or hot water).
@@ -396,23 +826,26 @@ void EstiaSerial::setTemperature(std::string zone, uint8_t temperature) {
 * @param onOff `1` `0`
 */
 void EstiaSerial::forceDefrost(uint8_t onOff) {
+	const CommandFrame* command = CommandTable::forcedDefrost(onOff);
+	if (command) {
+		this->queueCommand(*command);
+		return;
+	}
 	ForcedDefrostFrame defrostFrame(onOff);
 	this->queueCommand(defrostFrame);
 }
 
 void EstiaSerial::write(const uint8_t* buffer, uint8_t len, bool disableRx) {
-	digitalWrite(LED_BUILTIN, LOW);
 	if (disableRx) {
-		serial->enableRx(false);    // disable RX
+		transport->enableRx(false);    // disable RX
 	}
-	serial->enableIntTx(true);    // enable TX
-	serial->write(buffer, len);
-	serial->enableIntTx(false);    // disable TX
+	transport->enableTx(true);    // enable TX
+	transport->write(buffer, len);
+	transport->enableTx(false);    // disable TX
 	if (disableRx) {
-		serial->flush();           // empty serial RX buffer
-		serial->enableRx(true);    // enable RX
+		transport->flushRx();         // empty serial RX buffer
+		transport->enableRx(true);    // enable RX
 	}
-	digitalWrite(LED_BUILTIN, HIGH);
 }
 
 template <typename Frame>
@@ -420,17 +853,30 @@ void EstiaSerial::write(const Frame& frame, bool disableRx) {
 	this->write(frame.data(), frame.size(), disableRx);
 }
 
-bool EstiaSerial::read(ReadBuffer& buffer, bool byteDelay) {
-	if (!serial->available()) { return false; }
-
-	digitalWrite(LED_BUILTIN, LOW);
-	while (serial->available()) {
-		buffer.push_back(serial->read());
-		if (byteDelay) { delay(ESTIA_SERIAL_BYTE_DELAY); }
-		if (buffer.size() > 2 && EstiaFrame::readUint16(buffer, buffer.size() - 2) == FRAME_BEGIN) {    // new frame already began
-			break;
+/** Copy received bytes with receive timestamps.
+*
+* Transport does not timestamp bytes, so each byte gets earliest possible
+* receive time (after previous read and one character time after previous byte).
+* Times only estimate frame end, after loop delay chunk boundary looks like a gap,
+* frames are closed on line idle time measured from last read returning data (latest possible).
+*/
+bool EstiaSerial::read(ReadBuffer& buffer, ReadTimes& times) {
+	uint32_t now = transport->timestamp();
+	uint8_t chunk[ESTIA_SERIAL_READ_CHUNK];
+	bool received = false;
+	size_t len;
+	while ((len = transport->read(chunk, sizeof(chunk))) != 0) {
+		for (size_t idx = 0; idx < len; idx++) {
+			uint32_t rxTime = rxTimestamp + ESTIA_SERIAL_CHAR_TIME;
+			if (static_cast<int32_t>(lastReadTime - rxTime) > 0) { rxTime = lastReadTime; }
+			if (static_cast<int32_t>(rxTime - now) > 0) { rxTime = now; }
+			rxTimestamp = rxTime;
+			times.push_back(rxTime);
+			buffer.push_back(chunk[idx]);
 		}
+		received = true;
 	}
-	digitalWrite(LED_BUILTIN, HIGH);
-	return static_cast<bool>(serial->available());
+	if (received) { lastReceiveTime = now; }
+	lastReadTime = now;
+	return received;
 }
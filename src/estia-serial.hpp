@@ -18,33 +18,40 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "bus-scheduler.hpp"
+#include "command-queue.hpp"
 #include "config.h"
 #include "frames/commands-frames.hpp"
+#include "frames/commands-table.hpp"
 #include "frames/data-frames.hpp"
+#include "frames/frame-assembler.hpp"
+#include "frames/frame-classifier.hpp"
 #include "frames/frame-fixer.hpp"
 #include "frames/status-frames.hpp"
-#include <SoftwareSerial.h>
+#include "poll-scheduler.hpp"
+#include "sensor-history.hpp"
+#include "sensor-store.hpp"
+#include "transport/linux-serial-transport.hpp"
+#include "transport/software-serial-transport.hpp"
+#include "window-aggregator.hpp"
 #include <deque>
+#include <functional>
 #include <map>
 #include <string>
 
-#define ESTIA_SERIAL_BAUD 2400              // 2400
-#define ESTIA_SERIAL_CONFIG SWSERIAL_8E1    // 8E1
-#ifdef ARDUINO_ARCH_ESP32
-#define LED_BUILTIN 0
-#endif
 #define ESTIA_SERIAL_BYTE_DELAY 5        // 4.2 ms minimum for baud 2400
-#define ESTIA_SERIAL_READ_TIMEOUT 190    // maximum valid frame is 45 Bytes so max 189ms transmit time
-#define ESTIA_SERIAL_MIN_AVAILABLE 2     // minimum available bytes in serial buffer to start read
+#define ESTIA_SERIAL_IDLE_GAP 1.5        // line silence in character times closing frame
+#define ESTIA_SERIAL_READ_CHUNK 32       // bytes copied from transport at once
 
-#define SNIFFED_FRAMES_LIMIT 64
+#define SNIFFED_FRAMES_LIMIT 64    // frame slots allocated at begin()
 
 #define REQUEST_TIMEOUT 135    // response + heartbeat transmit time
 #define REQUEST_DELAY 110      // 2x shortest valid frame transmit time
 #define REQUEST_RETRIES 3
 
+#define STATUS_TEMPERATURE_MAX_AGE 65000    // ms, TWO/TWI from status frame (every 30 s) replace requests
+
 #define CMD_TIMEOUT 1000
-#define CMD_QUEUE_SIZE 10
 #define CMD_RETRIES 2
 
 struct SensorData {
@@ -53,42 +60,103 @@ struct SensorData {
 	float multiplier;
 };
 using DataToRequest = std::deque<std::string>;
-using EstiaData = std::map<std::string, SensorData>;
-using SniffedFrames = std::deque<FrameBuffer>;
-using CommandsQueue = std::deque<EstiaFrame>;
+using RequestCallback = std::function<void(int16_t value)>;
+using StatusHandler = std::function<void(const StatusData& data)>;
+using StatusChangeHandler = std::function<void(const StatusData& data, StatusChanges changes)>;
+using AckHandler = std::function<void(uint16_t frameCode)>;
+using SensorHandler = std::function<void(uint8_t code, int16_t value)>;
+
+/**
+* @param code data code
+* @param callback called with value or error code, empty for sensors data requests
+* @param polled periodic request from `PollScheduler`
+*/
+struct QueuedRequest {
+	QueuedRequest(uint8_t code, RequestCallback callback = nullptr, bool polled = false);
+	uint8_t code;
+	RequestCallback callback;
+	bool polled;
+};
+using RequestsQueue = std::deque<QueuedRequest>;
+using EstiaData = std::map<std::string, SensorData>;    // string keyed view of SensorStore
+using SniffedFrames = AssembledFrames;
+using SweepHandler = std::function<void(const SensorStore& sensors)>;
+using RawFrameHandler = std::function<void(const FrameView& frame)>;
 
 class EstiaSerial {
   private:
-	int8_t rxPin;
-	int8_t txPin;
+	using FrameHandler = bool (EstiaSerial::*)(const FrameView& frame);
+	static const FrameHandler frameHandlers[FrameClassifier::frame_kinds_count];
+
+	SensorStore sensors;
+	PollScheduler pollScheduler;
+	SensorHistory history;
+	WindowAggregator aggregator;
 	EstiaData sensorsData;
 	bool requestSent;
-	DataToRequest requestQueue;
+	RequestsQueue requestQueue;
 	uint32_t requestTimer;
 	uint8_t requestRetry;
+	bool responseWaiting;    // blocking `requestData()`
+	int16_t responseValue;
+	uint8_t passiveCode;       // requested by other device (remote controller)
+	uint32_t passiveTimer;
+	bool passivePending;
+	bool statusTemperatures;
 	ReadBuffer snifferBuffer;
-	FrameBuffer sniffedFrame;
+	ReadTimes snifferTimes;
+	uint32_t rxTimestamp;
+	uint32_t lastReadTime;
+	uint32_t lastReceiveTime;
+	FrameAssembler frameAssembler;
+	BusScheduler busScheduler;
 	SniffedFrames sniffedFrames;
 	StatusData statusData;
+	StatusChanges statusChanges;    // since status data was read
+	bool statusReceived;
+	PackedStatus packedStatus;
 	bool cmdSent;
-	CommandsQueue cmdQueue;
+	CommandQueue cmdQueue;
 	uint32_t cmdTimer;
 	uint8_t cmdRetry;
 
-	SoftwareSerial* serial;
+#ifdef ESTIA_TRANSPORT_SOFTWARE_SERIAL
+	SoftwareSerialTransport softwareSerialTransport;
+#endif
+	Transport* transport;
 	FrameFixer frameFixer;
+	StatusHandler statusHandler;
+	StatusChangeHandler statusChangeHandler;
+	AckHandler ackHandler;
+	SensorHandler sensorHandler;
+	SweepHandler sweepHandler;
+	RawFrameHandler rawFrameHandler;
 	void modeSwitch(std::string mode, uint8_t onOff);
 	void operationSwitch(std::string operation, uint8_t onOff);
-	bool splitSnifferBuffer(bool ignoreMinLen = false);
-	bool decodeStatus(FrameBuffer& buffer);
-	bool decodeAck(FrameBuffer& buffer);
-	bool decodeResponse(FrameBuffer& buffer);
-	void saveSensorData(uint16_t data);
-	void queueCommand(EstiaFrame& command);
+	size_t assembleFrames();
+	void decodeFrame(FrameBuffer& frame, FrameView::CrcState crc);
+	FrameView checkFrame(FrameBuffer& frame, FrameView::CrcState crc);
+	FrameClassifier::FrameKind frameReceived(const FrameView& view);
+	bool clearToSend(uint8_t length, uint8_t responseLength);
+	void releaseHandledFrames();
+	bool decodeStatus(const FrameView& buffer);
+	void saveStatusTemperatures();
+	bool decodeAck(const FrameView& buffer);
+	bool decodeRequest(const FrameView& buffer);
+	bool decodeResponse(const FrameView& buffer);
+	bool passiveResponse();
+	void decodePassive(const FrameView& buffer);
+	void observeSensorData(uint8_t code, int16_t value, uint32_t maxAge);
+	void completeRequest(int16_t value);
+	bool sensorsRequestPending();
+	void queuePoll();
+	void saveSensorData(uint8_t code, int16_t data, bool passive = false);
+	void queueCommand(const EstiaFrame& command);
+	void queueCommand(const CommandFrame& command);
 	bool sendCommand();
 	bool sendRequest();
 	void write(const uint8_t* buffer, uint8_t len, bool disableRx = true);
-	bool read(ReadBuffer& buffer, bool byteDelay = true);
+	bool read(ReadBuffer& buffer, ReadTimes& times);
 
   public:
 	enum ResponseError {
@@ -106,20 +174,52 @@ class EstiaSerial {
 		sniff_frame_pending,
 	};
 
+#ifdef ESTIA_TRANSPORT_SOFTWARE_SERIAL
 	EstiaSerial(uint8_t rxPin, uint8_t txPin);
+#endif
+	EstiaSerial(Transport& transport);
 
 	uint16_t frameAck;
 	bool newStatusData;
 	bool newSensorsData;
 
-	void begin();
+	bool begin();
 	SnifferState sniffer();
-	FrameBuffer getSniffedFrame();
+	FrameHandle getSniffedFrame();
 	uint16_t getAck();
+	uint32_t getRxOverflows();
+	uint32_t getFrameDrops();
+	const BusScheduler& getBusScheduler();
+	void setIdleGap(float charTimes);
 	StatusData& getStatusData();
+	StatusChanges getStatusChanges();
+	const PackedStatus& getPackedStatus();
 	EstiaData& getSensorsData();
+	const SensorStore& getSensors();
 	int16_t requestData(uint8_t requestCode);
 	int16_t requestData(std::string request);
+	bool requestDataAsync(uint8_t requestCode, RequestCallback callback);
+	bool requestDataAsync(std::string request, RequestCallback callback);
+	bool pollSensor(uint8_t requestCode, uint32_t period, PollScheduler::Priority priority = PollScheduler::priority_normal);
+	bool pollSensor(std::string request, uint32_t period, PollScheduler::Priority priority = PollScheduler::priority_normal);
+	const PollScheduler& getPollScheduler();
+	void setAdaptivePolling(bool enable, uint8_t maxBackoff = POLL_ADAPTIVE_MAX_BACKOFF);
+	void setPassiveMaxAge(uint32_t maxAge);
+	void setStatusTemperatures(bool enable);
+	float getRequestRate();
+	bool trackHistory(uint8_t requestCode, size_t bytes);
+	bool trackHistory(std::string request, size_t bytes);
+	const HistoryRing* getHistory(uint8_t requestCode);
+	void setAggregationWindow(uint32_t length);
+	void onWindow(WindowHandler handler);
+	void onStatus(StatusHandler handler);
+	void onStatusChange(StatusChangeHandler handler);
+	void onAck(AckHandler handler);
+	void onSensor(SensorHandler handler);
+	void onSweepComplete(SweepHandler handler);
+	void onRawFrame(RawFrameHandler handler);
+	void onCommandDrop(CommandQueue::DropHandler handler);
+	const CommandQueue& getCommandQueue();
 	void clearSensorsData();
 	bool requestSensorsData(DataToRequest&& sensorsToRequest = {SENSORS_DATA_TO_REQUEST}, bool clear = false);
 	bool requestSensorsData(DataToRequest& sensorsToRequest, bool clear = false);
@@ -18,45 +18,81 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 
 #include "commands-frames.hpp"
 
+// name catalogs sorted by name (binary search)
+constexpr ModeByName modeByName PROGMEM = {{
+    {"auto", SET_AUTO_MODE_CODE},
+    {"night", SET_NIGHT_MODE_CODE},
+    {"quiet", SET_QUIET_MODE_CODE},
+}};
+constexpr OperationModeByName operationModeByName PROGMEM = {{
+    {"cooling", OPERATION_MODE_COOLING},
+    {"heating", OPERATION_MODE_HEATING},
+}};
+constexpr SwitchOperationByName switchOperationByName PROGMEM = {{
+    {"cooling", SWITCH_OPERATION_COOL_HEAT},
+    {"heating", SWITCH_OPERATION_COOL_HEAT},
+    {"hot_water", SWITCH_OPERATION_HOT_WATER},
+}};
+constexpr TemperatureByName temperatureByName PROGMEM = {{
+    {"cooling", TEMPERATURE_COOLING_CODE},
+    {"heating", TEMPERATURE_HEATING_CODE},
+    {"hot_water", TEMPERATURE_HOT_WATER_CODE},
+}};
+static_assert(modeByName.sorted(), "modeByName names must be sorted");
+static_assert(operationModeByName.sorted(), "operationModeByName names must be sorted");
+static_assert(switchOperationByName.sorted(), "switchOperationByName names must be sorted");
+static_assert(temperatureByName.sorted(), "temperatureByName names must be sorted");
+
+// documented frames (commands-frames.hpp) reproduced at compile time
+constexpr uint8_t autoModeOnFrame[] = {0xa0, 0x00, 0x11, 0x0b, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc4, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03};
+constexpr uint8_t autoModeOffFrame[] = {0xa0, 0x00, 0x11, 0x0b, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc4, 0x01, 0x00, 0x00, 0x00, 0xde, 0xdf};
+constexpr uint8_t quietModeOnFrame[] = {0xa0, 0x00, 0x11, 0x0b, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc4, 0x04, 0x04, 0x00, 0x00, 0xd3, 0xe9};
+constexpr uint8_t quietModeOffFrame[] = {0xa0, 0x00, 0x11, 0x0b, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc4, 0x04, 0x00, 0x00, 0x00, 0xb0, 0x88};
+constexpr uint8_t nightModeOnFrame[] = {0xa0, 0x00, 0x11, 0x0b, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc4, 0x88, 0x08, 0x00, 0x00, 0xcc, 0x10};
+constexpr uint8_t nightModeOffFrame[] = {0xa0, 0x00, 0x11, 0x0b, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc4, 0x88, 0x00, 0x00, 0x00, 0x0a, 0xd2};
+constexpr uint8_t coolingModeFrame[] = {0xa0, 0x00, 0x11, 0x08, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc0, 0x05, 0xb1, 0x7c};
+constexpr uint8_t heatingModeFrame[] = {0xa0, 0x00, 0x11, 0x08, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc0, 0x06, 0x83, 0xe7};
+constexpr uint8_t coolHeatOnFrame[] = {0xa0, 0x00, 0x11, 0x08, 0x00, 0x00, 0x40, 0x08, 0x00, 0x00, 0x41, 0x23, 0x8f, 0x38};
+constexpr uint8_t coolHeatOffFrame[] = {0xa0, 0x00, 0x11, 0x08, 0x00, 0x00, 0x40, 0x08, 0x00, 0x00, 0x41, 0x22, 0x9e, 0xb1};
+constexpr uint8_t hotWaterOnFrame[] = {0xa0, 0x00, 0x11, 0x08, 0x00, 0x00, 0x40, 0x08, 0x00, 0x00, 0x41, 0x2c, 0x77, 0xcf};
+constexpr uint8_t hotWaterOffFrame[] = {0xa0, 0x00, 0x11, 0x08, 0x00, 0x00, 0x40, 0x08, 0x00, 0x00, 0x41, 0x28, 0x31, 0xeb};
+constexpr uint8_t coolingTempFrame[] = {0xa0, 0x00, 0x11, 0x0c, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc1, 0x01, 0x4a, 0x4a, 0x76, 0x4a, 0xd4, 0x3f};
+constexpr uint8_t heatingTempFrame[] = {0xa0, 0x00, 0x11, 0x0c, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc1, 0x02, 0x5c, 0x7a, 0x76, 0x5c, 0xb2, 0xd1};
+constexpr uint8_t hotWaterTempFrame[] = {0xa0, 0x00, 0x11, 0x0c, 0x00, 0x00, 0x40, 0x08, 0x00, 0x03, 0xc1, 0x08, 0x00, 0x00, 0x70, 0x00, 0x83, 0xc0};
+constexpr uint8_t defrostOnFrame[] = {0xa0, 0x00, 0x11, 0x0a, 0x00, 0x00, 0x40, 0x08, 0x00, 0x00, 0x15, 0x00, 0x46, 0x01, 0xe7, 0x25};
+constexpr uint8_t defrostOffFrame[] = {0xa0, 0x00, 0x11, 0x0a, 0x00, 0x00, 0x40, 0x08, 0x00, 0x00, 0x15, 0x00, 0x46, 0x00, 0xf6, 0xac};
+
+static_assert(SetModeFrame::build(SET_AUTO_MODE_CODE, 1).equals(autoModeOnFrame, sizeof(autoModeOnFrame)), "auto mode on");
+static_assert(SetModeFrame::build(SET_AUTO_MODE_CODE, 0).equals(autoModeOffFrame, sizeof(autoModeOffFrame)), "auto mode off");
+static_assert(SetModeFrame::build(SET_QUIET_MODE_CODE, 1).equals(quietModeOnFrame, sizeof(quietModeOnFrame)), "quiet mode on");
+static_assert(SetModeFrame::build(SET_QUIET_MODE_CODE, 0).equals(quietModeOffFrame, sizeof(quietModeOffFrame)), "quiet mode off");
+static_assert(SetModeFrame::build(SET_NIGHT_MODE_CODE, 1).equals(nightModeOnFrame, sizeof(nightModeOnFrame)), "night mode on");
+static_assert(SetModeFrame::build(SET_NIGHT_MODE_CODE, 0).equals(nightModeOffFrame, sizeof(nightModeOffFrame)), "night mode off");
+static_assert(OperationMode::build(OPERATION_MODE_COOLING).equals(coolingModeFrame, sizeof(coolingModeFrame)), "cooling operation");
+static_assert(OperationMode::build(OPERATION_MODE_HEATING).equals(heatingModeFrame, sizeof(heatingModeFrame)), "heating operation");
+static_assert(SwitchFrame::build(SWITCH_OPERATION_COOL_HEAT, 1).equals(coolHeatOnFrame, sizeof(coolHeatOnFrame)), "cooling/heating on");
+static_assert(SwitchFrame::build(SWITCH_OPERATION_COOL_HEAT, 0).equals(coolHeatOffFrame, sizeof(coolHeatOffFrame)), "cooling/heating off");
+static_assert(SwitchFrame::build(SWITCH_OPERATION_HOT_WATER, 1).equals(hotWaterOnFrame, sizeof(hotWaterOnFrame)), "hot water on");
+static_assert(SwitchFrame::build(SWITCH_OPERATION_HOT_WATER, 0).equals(hotWaterOffFrame, sizeof(hotWaterOffFrame)), "hot water off");
+static_assert(TemperatureFrame::build(TEMPERATURE_COOLING_CODE, 21, 21, 43).equals(coolingTempFrame, sizeof(coolingTempFrame)), "cooling temperature");
+static_assert(TemperatureFrame::build(TEMPERATURE_HEATING_CODE, 30, 45, 43).equals(heatingTempFrame, sizeof(heatingTempFrame)), "heating temperature");
+static_assert(TemperatureFrame::build(TEMPERATURE_HOT_WATER_CODE, 0, 0, 40).equals(hotWaterTempFrame, sizeof(hotWaterTempFrame)), "hot water temperature");
+static_assert(ForcedDefrostFrame::build(1).equals(defrostOnFrame, sizeof(defrostOnFrame)), "force defrost on");
+static_assert(ForcedDefrostFrame::build(0).equals(defrostOffFrame, sizeof(defrostOffFrame)), "force defrost off");
+
 SetModeFrame::SetModeFrame(uint8_t mode, uint8_t onOff)
-    : EstiaFrame::EstiaFrame(FRAME_TYPE_CMD, FRAME_SET_MODE_LEN)
+    : EstiaFrame::EstiaFrame(build(mode, onOff))
     , mode(mode)
-    , onOff(modeOnOff(onOff)) {
-	setSrc(SET_MODE_SRC);
-	setDst(SET_MODE_DST);
-	setDataType(FRAME_DATA_TYPE_MODE_CHANGE);
-	setByte(SET_MODE_CODE_OFFSET, mode);
-	setByte(SET_MODE_VALUE_OFFSET, this->onOff, true);
+    , onOff(modeOnOff(mode, onOff)) {
 }
 
 SetModeFrame::SetModeFrame(std::string mode, uint8_t onOff)
     : SetModeFrame::SetModeFrame(modeByName.at(mode), onOff) {
 }
 
-uint8_t SetModeFrame::modeOnOff(uint8_t onOff) {
-	switch (mode) {
-	case SET_AUTO_MODE_CODE:
-		return onOff;
-		break;
-
-	case SET_QUIET_MODE_CODE:
-		return onOff << 2;
-		break;
-
-	case SET_NIGHT_MODE_CODE:
-		return onOff << 3;
-		break;
-	}
-	return onOff;
-}
-
 OperationMode::OperationMode(uint8_t mode)
-    : EstiaFrame::EstiaFrame(FRAME_TYPE_CMD, FRAME_OPERATION_MODE_LEN)
+    : EstiaFrame::EstiaFrame(build(mode))
     , mode(mode) {
-	setSrc(OPERATION_MODE_SRC);
-	setDst(OPERATION_MODE_DST);
-	setDataType(FRAME_DATA_TYPE_OPERATION_MODE);
-	setByte(OPERATION_MODE_OFFSET, this->mode, true);
 }
 
 OperationMode::OperationMode(std::string mode)
@@ -64,91 +100,33 @@ OperationMode::OperationMode(std::string mode)
 }
 
 SwitchFrame::SwitchFrame(uint8_t operation, uint8_t onOff)
-    : EstiaFrame::EstiaFrame(FRAME_TYPE_CMD, FRAME_SWITCH_LEN)
+    : EstiaFrame::EstiaFrame(build(operation, onOff))
     , operation(operation)
-    , onOff(operationOnOff(onOff)) {
-	setSrc(SWITCH_SRC);
-	setDst(SWITCH_DST);
-	setDataType(FRAME_DATA_TYPE_OPERATION_SWITCH);
-	setByte(SWITCH_VALUE_OFFSET, this->onOff, true);
+    , onOff(operationOnOff(operation, onOff)) {
 }
 
 SwitchFrame::SwitchFrame(std::string operation, uint8_t onOff)
     : SwitchFrame::SwitchFrame(switchOperationByName.at(operation), onOff) {
 }
 
-uint8_t SwitchFrame::operationOnOff(uint8_t onOff) {
-	switch (operation) {
-	case SWITCH_OPERATION_COOL_HEAT:
-		return operation + onOff;
-		break;
-
-	case SWITCH_OPERATION_HOT_WATER:
-		return operation + (onOff << 2);
-		break;
-	}
-	return onOff;
-}
-
 TemperatureFrame::TemperatureFrame(uint8_t zone, uint8_t zone1Temperature, uint8_t zone2Temperature, uint8_t hotWaterTemperature)
-    : EstiaFrame::EstiaFrame(FRAME_TYPE_CMD, FRAME_TEMPERATURE_LEN)
+    : EstiaFrame::EstiaFrame(build(zone, zone1Temperature, zone2Temperature, hotWaterTemperature))
     , zone(zone)
-    , zone1Temperature(constrainTemp(zone1Temperature))
-    , zone2Temperature(constrainTemp(zone2Temperature))
-    , hotWaterTemperature(constrainTemp(hotWaterTemperature)) {
-	setSrc(TEMPERATURE_SRC);
-	setDst(TEMPERATURE_DST);
-	setDataType(FRAME_DATA_TYPE_TEMPERATURE_CHANGE);
-	setByte(TEMPERATURE_CODE_OFFSET, zone);
-	switch (zone) {
-	case TEMPERATURE_COOLING_CODE:
-	case TEMPERATURE_HEATING_CODE:
-		setByte(TEMPERATURE_ZONE1_VALUE_OFFSET, convertTemp(this->zone1Temperature));
-		setByte(TEMPERATURE_ZONE2_VALUE_OFFSET, convertTemp(this->zone2Temperature));
-		setByte(TEMPERATURE_HOT_WATER_VALUE_OFFSET, convertTemp(this->hotWaterTemperature));
-		setByte(TEMPERATURE_ZONE1_VALUE2_OFFSET, convertTemp(this->zone1Temperature), true);
-		break;
-
-	case TEMPERATURE_HOT_WATER_CODE:
-		setByte(TEMPERATURE_HOT_WATER_VALUE_OFFSET, convertTemp(this->hotWaterTemperature), true);
-		break;
-	}
-}
-
-uint8_t TemperatureFrame::constrainTemp(uint8_t temperature) {
-	uint8_t constrained = temperature;
-	switch (zone) {
-	case TEMPERATURE_COOLING_CODE:
-		constrained = constrain(temperature, MIN_COOLING_TEMP, MIN_COOLING_TEMP);
-		break;
-
-	case TEMPERATURE_HEATING_CODE:
-		constrained = constrain(temperature, MIN_HEATING_TEMP, MAX_HEATING_TEMP);
-		break;
-
-	case TEMPERATURE_HOT_WATER_CODE:
-		constrained = constrain(temperature, MIN_HOT_WATER_TEMP, MAX_HOT_WATER_TEMP);
-		break;
-	}
-	return constrained;
-}
-
-uint8_t TemperatureFrame::convertTemp(uint8_t temperature) {
-	return (temperature + 16) * 2;
+    , zone1Temperature(constrainTemp(zone, zone1Temperature))
+    , zone2Temperature(constrainTemp(zone, zone2Temperature))
+    , hotWaterTemperature(constrainTemp(TEMPERATURE_HOT_WATER_CODE, hotWaterTemperature)) {
 }
 
 ForcedDefrostFrame::ForcedDefrostFrame(uint8_t onOff)
-    : EstiaFrame::EstiaFrame(FRAME_TYPE_CMD, FRAME_FORCE_DEFROST_LEN)
+    : EstiaFrame::EstiaFrame(build(onOff))
+    , code(FORCE_DEFROST_CODE)
     , onOff(onOff) {
-	setSrc(FORCE_DEFROST_SRC);
-	setDst(FORCE_DEFROST_DST);
-	setDataType(FRAME_DATA_TYPE_SPECIAL_CMD);
-	setByte(FORCE_DEFROST_CODE_OFFSET, FORCE_DEFROST_CODE);
-	setByte(FORCE_DEFROST_VALUE_OFFSET, this->onOff, true);
 }
 
-AckFrame::AckFrame(FrameBuffer&& buffer)
-    : EstiaFrame::EstiaFrame(buffer, FRAME_ACK_LEN) {
+AckFrame::AckFrame(const FrameView& buffer)
+    : ReceivedFrame::ReceivedFrame(buffer, FRAME_ACK_LEN)
+    , frameCode(0x0000)
+    , error(0) {
 	error = checkFrame(FRAME_TYPE_ACK, FRAME_DATA_TYPE_ACK);
 	if (error == err_ok) {
 		frameCode = readUint16(ACK_FRAME_CODE_OFFSET);
@@ -156,9 +134,5 @@ AckFrame::AckFrame(FrameBuffer&& buffer)
 }
 
 AckFrame::AckFrame(FrameBuffer& buffer)
-    : AckFrame::AckFrame(std::forward<FrameBuffer>(buffer)) {
-}
-
-AckFrame::AckFrame(ReadBuffer& buffer)
-    : AckFrame::AckFrame(readBuffToFrameBuff(buffer)) {
+    : AckFrame::AckFrame(FrameView(buffer)) {
 }
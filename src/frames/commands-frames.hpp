@@ -19,10 +19,10 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include "../config.h"
+#include "../host/arduino-compat.hpp"
 #include "frame.hpp"
-#include <Arduino.h>
+#include "name-catalog.hpp"
 #include <string>
-#include <unordered_map>
 
 #define SET_MODE_SRC FRAME_SRC_DST_REMOTE
 #define SET_MODE_DST FRAME_SRC_DST_MASTER
@@ -34,8 +34,8 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 #define SET_NIGHT_MODE_CODE 0x88
 
 // auto mode on/off
-// a0 00 11 0b 00 00 40 08 00 03 c4 01 00 00 00 de df -> on,  offset 12 value 0x01
-// a0 00 11 0b 00 00 40 08 00 03 c4 01 01 00 00 84 03 -> off, offset 12 value 0x00
+// a0 00 11 0b 00 00 40 08 00 03 c4 01 01 00 00 84 03 -> on,  offset 12 value 0x01
+// a0 00 11 0b 00 00 40 08 00 03 c4 01 00 00 00 de df -> off, offset 12 value 0x00
 // quiet mode on/off
 // a0 00 11 0b 00 00 40 08 00 03 c4 04 04 00 00 d3 e9 -> on,  offset 12 value 0x04 (1<<2)
 // a0 00 11 0b 00 00 40 08 00 03 c4 04 00 00 00 b0 88 -> off, offset 12 value 0x00
@@ -43,23 +43,39 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 // a0 00 11 0b 00 00 40 08 00 03 c4 88 08 00 00 cc 10 -> on,  offset 12 value 0x08 (1<<3)
 // a0 00 11 0b 00 00 40 08 00 03 c4 88 00 00 00 0a d2 -> off, offset 12 value 0x00
 
-using ModeByName = std::unordered_map<std::string, uint8_t>;
+using ModeByName = NameCatalog<uint8_t, 3>;
 
-const ModeByName modeByName = {
-    {"auto", SET_AUTO_MODE_CODE},
-    {"quiet", SET_QUIET_MODE_CODE},
-    {"night", SET_NIGHT_MODE_CODE}};
+extern const ModeByName modeByName;
 
 class SetModeFrame : public EstiaFrame {
   private:
 	uint8_t mode;
 	uint8_t onOff;
 
-	uint8_t modeOnOff(uint8_t onOff);
+	static constexpr uint8_t modeOnOff(uint8_t mode, uint8_t onOff) {
+		switch (mode) {
+		case SET_AUTO_MODE_CODE:
+			return onOff;
+
+		case SET_QUIET_MODE_CODE:
+			return onOff << 2;
+
+		case SET_NIGHT_MODE_CODE:
+			return onOff << 3;
+		}
+		return onOff;
+	}
 
   public:
 	SetModeFrame(uint8_t mode, uint8_t onOff);
 	SetModeFrame(std::string mode, uint8_t onOff);
+
+	static constexpr CommandFrame build(uint8_t mode, uint8_t onOff) {
+		return CommandFrame(FRAME_TYPE_CMD, FRAME_SET_MODE_LEN, SET_MODE_SRC, SET_MODE_DST, FRAME_DATA_TYPE_MODE_CHANGE)
+		    .setByte(SET_MODE_CODE_OFFSET, mode)
+		    .setByte(SET_MODE_VALUE_OFFSET, modeOnOff(mode, onOff))
+		    .updateCrc();
+	}
 };
 
 // cooling/heating operation
@@ -72,11 +88,9 @@ class SetModeFrame : public EstiaFrame {
 #define OPERATION_MODE_COOLING 0x05
 #define OPERATION_MODE_HEATING 0x06
 
-using OperationModeByName = std::unordered_map<std::string, uint8_t>;
+using OperationModeByName = NameCatalog<uint8_t, 2>;
 
-const OperationModeByName operationModeByName = {
-    {"cooling", OPERATION_MODE_COOLING},
-    {"heating", OPERATION_MODE_HEATING}};
+extern const OperationModeByName operationModeByName;
 
 class OperationMode : public EstiaFrame {
   private:
@@ -85,6 +99,12 @@ class OperationMode : public EstiaFrame {
   public:
 	OperationMode(uint8_t mode);
 	OperationMode(std::string mode);
+
+	static constexpr CommandFrame build(uint8_t mode) {
+		return CommandFrame(FRAME_TYPE_CMD, FRAME_OPERATION_MODE_LEN, OPERATION_MODE_SRC, OPERATION_MODE_DST, FRAME_DATA_TYPE_OPERATION_MODE)
+		    .setByte(OPERATION_MODE_OFFSET, mode)
+		    .updateCrc();
+	}
 };
 
 
@@ -101,23 +121,35 @@ class OperationMode : public EstiaFrame {
 // a0 00 11 08 00 00 40 08 00 00 41 2c 77 cf -> on,  0x2c offset 11
 // a0 00 11 08 00 00 40 08 00 00 41 28 31 eb -> off, 0x28 offset 11
 
-using SwitchOperationByName = std::unordered_map<std::string, uint8_t>;
+using SwitchOperationByName = NameCatalog<uint8_t, 3>;
 
-const SwitchOperationByName switchOperationByName = {
-    {"cooling", SWITCH_OPERATION_COOL_HEAT},
-    {"heating", SWITCH_OPERATION_COOL_HEAT},
-    {"hot_water", SWITCH_OPERATION_HOT_WATER}};
+extern const SwitchOperationByName switchOperationByName;
 
 class SwitchFrame : public EstiaFrame {
   private:
 	uint8_t operation;
 	uint8_t onOff;
 
-	uint8_t operationOnOff(uint8_t onOff);
+	static constexpr uint8_t operationOnOff(uint8_t operation, uint8_t onOff) {
+		switch (operation) {
+		case SWITCH_OPERATION_COOL_HEAT:
+			return operation + onOff;
+
+		case SWITCH_OPERATION_HOT_WATER:
+			return operation + (onOff << 2);
+		}
+		return onOff;
+	}
 
   public:
 	SwitchFrame(uint8_t operation, uint8_t onOff);
 	SwitchFrame(std::string operation, uint8_t onOff);
+
+	static constexpr CommandFrame build(uint8_t operation, uint8_t onOff) {
+		return CommandFrame(FRAME_TYPE_CMD, FRAME_SWITCH_LEN, SWITCH_SRC, SWITCH_DST, FRAME_DATA_TYPE_OPERATION_SWITCH)
+		    .setByte(SWITCH_VALUE_OFFSET, operationOnOff(operation, onOff))
+		    .updateCrc();
+	}
 };
 
 #define TEMPERATURE_SRC FRAME_SRC_DST_REMOTE
@@ -131,12 +163,9 @@ class SwitchFrame : public EstiaFrame {
 #define TEMPERATURE_HOT_WATER_VALUE_OFFSET 14
 #define TEMPERATURE_ZONE1_VALUE2_OFFSET 15
 
-using TemperatureByName = std::unordered_map<std::string, uint8_t>;
+using TemperatureByName = NameCatalog<uint8_t, 3>;
 
-const TemperatureByName temperatureByName = {
-    {"cooling", TEMPERATURE_COOLING_CODE},
-    {"heating", TEMPERATURE_HEATING_CODE},
-    {"hot_water", TEMPERATURE_HOT_WATER_CODE}};
+extern const TemperatureByName temperatureByName;
 
 // cooling temperature
 // a0 00 11 0c 00 00 40 08 00 03 c1 01 4a 4a 76 4a d4 3f -> cooling temperature change, offset 12, 13 and 15, value = (temp + 16) * 2
@@ -152,11 +181,43 @@ class TemperatureFrame : public EstiaFrame {
 	uint8_t zone2Temperature;
 	uint8_t hotWaterTemperature;
 
-	uint8_t constrainTemp(uint8_t temperature);
-	uint8_t convertTemp(uint8_t temperature);
-
   public:
 	TemperatureFrame(uint8_t zone, uint8_t zone1Temperature, uint8_t zone2Temperature, uint8_t hotWaterTemperature);
+
+	/**
+	* @param zone `TEMPERATURE_COOLING_CODE` `TEMPERATURE_HEATING_CODE` `TEMPERATURE_HOT_WATER_CODE`
+	* @param temperature value to constrain to zone limits (config.h)
+	*/
+	static constexpr uint8_t constrainTemp(uint8_t zone, uint8_t temperature) {
+		switch (zone) {
+		case TEMPERATURE_COOLING_CODE:
+			return temperature < MIN_COOLING_TEMP ? MIN_COOLING_TEMP : temperature > MAX_COOLING_TEMP ? MAX_COOLING_TEMP : temperature;
+
+		case TEMPERATURE_HEATING_CODE:
+			return temperature < MIN_HEATING_TEMP ? MIN_HEATING_TEMP : temperature > MAX_HEATING_TEMP ? MAX_HEATING_TEMP : temperature;
+
+		case TEMPERATURE_HOT_WATER_CODE:
+			return temperature < MIN_HOT_WATER_TEMP ? MIN_HOT_WATER_TEMP : temperature > MAX_HOT_WATER_TEMP ? MAX_HOT_WATER_TEMP : temperature;
+		}
+		return temperature;
+	}
+	static constexpr uint8_t convertTemp(uint8_t temperature) {
+		return (temperature + 16) * 2;
+	}
+	static constexpr CommandFrame build(uint8_t zone, uint8_t zone1Temperature, uint8_t zone2Temperature, uint8_t hotWaterTemperature) {
+		return zone == TEMPERATURE_HOT_WATER_CODE
+		           ? CommandFrame(FRAME_TYPE_CMD, FRAME_TEMPERATURE_LEN, TEMPERATURE_SRC, TEMPERATURE_DST, FRAME_DATA_TYPE_TEMPERATURE_CHANGE)
+		                 .setByte(TEMPERATURE_CODE_OFFSET, zone)
+		                 .setByte(TEMPERATURE_HOT_WATER_VALUE_OFFSET, convertTemp(constrainTemp(zone, hotWaterTemperature)))
+		                 .updateCrc()
+		           : CommandFrame(FRAME_TYPE_CMD, FRAME_TEMPERATURE_LEN, TEMPERATURE_SRC, TEMPERATURE_DST, FRAME_DATA_TYPE_TEMPERATURE_CHANGE)
+		                 .setByte(TEMPERATURE_CODE_OFFSET, zone)
+		                 .setByte(TEMPERATURE_ZONE1_VALUE_OFFSET, convertTemp(constrainTemp(zone, zone1Temperature)))
+		                 .setByte(TEMPERATURE_ZONE2_VALUE_OFFSET, convertTemp(constrainTemp(zone, zone2Temperature)))
+		                 .setByte(TEMPERATURE_HOT_WATER_VALUE_OFFSET, convertTemp(constrainTemp(TEMPERATURE_HOT_WATER_CODE, hotWaterTemperature)))
+		                 .setByte(TEMPERATURE_ZONE1_VALUE2_OFFSET, convertTemp(constrainTemp(zone, zone1Temperature)))
+		                 .updateCrc();
+	}
 };
 
 #define FORCE_DEFROST_SRC FRAME_SRC_DST_REMOTE
@@ -177,6 +238,13 @@ class ForcedDefrostFrame : public EstiaFrame {
 
   public:
 	ForcedDefrostFrame(uint8_t onOff);
+
+	static constexpr CommandFrame build(uint8_t onOff) {
+		return CommandFrame(FRAME_TYPE_CMD, FRAME_FORCE_DEFROST_LEN, FORCE_DEFROST_SRC, FORCE_DEFROST_DST, FRAME_DATA_TYPE_SPECIAL_CMD)
+		    .setByte(FORCE_DEFROST_CODE_OFFSET, FORCE_DEFROST_CODE)
+		    .setByte(FORCE_DEFROST_VALUE_OFFSET, onOff)
+		    .updateCrc();
+	}
 };
 
 #define ACK_SRC FRAME_SRC_DST_MASTER
@@ -186,12 +254,13 @@ class ForcedDefrostFrame : public EstiaFrame {
 // ack
 // a0 00 18 09 00 08 00 08 00 00 a1 00 41 c1 95 -> frame with data type 0x0041 ack'd
 
-class AckFrame : public EstiaFrame {
+class AckFrame : public ReceivedFrame {
   private:
   public:
-	AckFrame(FrameBuffer&& buffer);
+	AckFrame(const FrameView& buffer);
 	AckFrame(FrameBuffer& buffer);
-	AckFrame(ReadBuffer& buffer);
+	AckFrame(FrameBuffer&& buffer) = delete;    // frame is not copied, view would dangle
+	AckFrame(ReadBuffer& buffer) = delete;
 
 	uint16_t frameCode;
 	uint8_t error;
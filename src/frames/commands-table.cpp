@@ -0,0 +1,93 @@
+/*
+commands-table.cpp - Estia R32 heat pump pre-encoded commands frames
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "commands-table.hpp"
+
+constexpr CommandTable::CommandTable()
+    : frames() {
+	frames[idx_auto_off] = SetModeFrame::build(SET_AUTO_MODE_CODE, 0);
+	frames[idx_auto_on] = SetModeFrame::build(SET_AUTO_MODE_CODE, 1);
+	frames[idx_quiet_off] = SetModeFrame::build(SET_QUIET_MODE_CODE, 0);
+	frames[idx_quiet_on] = SetModeFrame::build(SET_QUIET_MODE_CODE, 1);
+	frames[idx_night_off] = SetModeFrame::build(SET_NIGHT_MODE_CODE, 0);
+	frames[idx_night_on] = SetModeFrame::build(SET_NIGHT_MODE_CODE, 1);
+	frames[idx_cooling_mode] = OperationMode::build(OPERATION_MODE_COOLING);
+	frames[idx_heating_mode] = OperationMode::build(OPERATION_MODE_HEATING);
+	frames[idx_cool_heat_off] = SwitchFrame::build(SWITCH_OPERATION_COOL_HEAT, 0);
+	frames[idx_cool_heat_on] = SwitchFrame::build(SWITCH_OPERATION_COOL_HEAT, 1);
+	frames[idx_hot_water_off] = SwitchFrame::build(SWITCH_OPERATION_HOT_WATER, 0);
+	frames[idx_hot_water_on] = SwitchFrame::build(SWITCH_OPERATION_HOT_WATER, 1);
+	frames[idx_defrost_off] = ForcedDefrostFrame::build(0);
+	frames[idx_defrost_on] = ForcedDefrostFrame::build(1);
+	for (uint8_t idx = 0; idx < COMMAND_TABLE_HOT_WATER_TEMPS; idx++) {
+		frames[idx_hot_water_temp + idx] = TemperatureFrame::build(TEMPERATURE_HOT_WATER_CODE, 0, 0, MIN_HOT_WATER_TEMP + idx);
+	}
+}
+
+static constexpr CommandTable commandTable PROGMEM = CommandTable();
+
+const CommandFrame* CommandTable::frame(uint8_t index) {
+	return &commandTable.frames[index];
+}
+
+const CommandFrame* CommandTable::setMode(uint8_t mode, uint8_t onOff) {
+	if (onOff > 1) { return nullptr; }
+	switch (mode) {
+	case SET_AUTO_MODE_CODE:
+		return frame(idx_auto_off + onOff);
+
+	case SET_QUIET_MODE_CODE:
+		return frame(idx_quiet_off + onOff);
+
+	case SET_NIGHT_MODE_CODE:
+		return frame(idx_night_off + onOff);
+	}
+	return nullptr;
+}
+
+const CommandFrame* CommandTable::operationMode(uint8_t mode) {
+	switch (mode) {
+	case OPERATION_MODE_COOLING:
+		return frame(idx_cooling_mode);
+
+	case OPERATION_MODE_HEATING:
+		return frame(idx_heating_mode);
+	}
+	return nullptr;
+}
+
+const CommandFrame* CommandTable::switchOperation(uint8_t operation, uint8_t onOff) {
+	if (onOff > 1) { return nullptr; }
+	switch (operation) {
+	case SWITCH_OPERATION_COOL_HEAT:
+		return frame(idx_cool_heat_off + onOff);
+
+	case SWITCH_OPERATION_HOT_WATER:
+		return frame(idx_hot_water_off + onOff);
+	}
+	return nullptr;
+}
+
+const CommandFrame* CommandTable::forcedDefrost(uint8_t onOff) {
+	if (onOff > 1) { return nullptr; }
+	return frame(idx_defrost_off + onOff);
+}
+
+const CommandFrame* CommandTable::hotWaterTemperature(uint8_t temperature) {
+	return frame(idx_hot_water_temp + TemperatureFrame::constrainTemp(TEMPERATURE_HOT_WATER_CODE, temperature) - MIN_HOT_WATER_TEMP);
+}
@@ -0,0 +1,65 @@
+/*
+commands-table.hpp - Estia R32 heat pump pre-encoded commands frames
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "commands-frames.hpp"
+
+#define COMMAND_TABLE_HOT_WATER_TEMPS (MAX_HOT_WATER_TEMP - MIN_HOT_WATER_TEMP + 1)
+
+/** Compile time generated, CRC complete commands frames stored in flash.
+*
+* Covers modes on/off, operation modes, operation switches, forced defrost
+* and hot water temperatures (config.h limits). Cooling and heating temperature
+* frames carry current targets of other zones, use `TemperatureFrame::build()` for those.
+* Lookups return `nullptr` for values not in table.
+*/
+class CommandTable {
+  private:
+	enum Index : uint8_t {
+		idx_auto_off,
+		idx_auto_on,
+		idx_quiet_off,
+		idx_quiet_on,
+		idx_night_off,
+		idx_night_on,
+		idx_cooling_mode,
+		idx_heating_mode,
+		idx_cool_heat_off,
+		idx_cool_heat_on,
+		idx_hot_water_off,
+		idx_hot_water_on,
+		idx_defrost_off,
+		idx_defrost_on,
+		idx_hot_water_temp,
+		idx_count = idx_hot_water_temp + COMMAND_TABLE_HOT_WATER_TEMPS,
+	};
+
+	CommandFrame frames[idx_count];
+
+	static const CommandFrame* frame(uint8_t index);
+
+  public:
+	constexpr CommandTable();
+
+	static const CommandFrame* setMode(uint8_t mode, uint8_t onOff);
+	static const CommandFrame* operationMode(uint8_t mode);
+	static const CommandFrame* switchOperation(uint8_t operation, uint8_t onOff);
+	static const CommandFrame* forcedDefrost(uint8_t onOff);
+	static const CommandFrame* hotWaterTemperature(uint8_t temperature);
+};
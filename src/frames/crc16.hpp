@@ -0,0 +1,60 @@
+/*
+crc16.hpp - Estia R32 heat pump frames CRC-16/MCRF4XX
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../host/arduino-compat.hpp"
+#include <stddef.h>
+#include <stdint.h>
+
+#define CRC16_INIT 0xffff       // CRC-16/MCRF4XX initial value
+#define CRC16_POLY 0x8408       // 0x1021 reflected
+#define CRC16_XOR_OUT 0x0000    // no final xor
+
+/** Table driven CRC-16/MCRF4XX.
+*
+* One shot: `Crc16::calculate(data, len)`
+*
+* Incremental:
+* ```
+* uint16_t crc = Crc16::init();
+* crc = Crc16::update(crc, byte);         // as bytes arrive
+* crc = Crc16::update(crc, data, len);    // or in chunks
+* crc = Crc16::finalize(crc);
+* ```
+* Lookup table (512 Bytes) is stored in flash.
+* `Crc16::compute()` is bitwise constexpr variant for compile time frames.
+*/
+class Crc16 {
+  public:
+	static uint16_t init();
+	static uint16_t update(uint16_t crc, uint8_t byte);
+	static uint16_t update(uint16_t crc, const uint8_t* data, size_t len);
+	static uint16_t finalize(uint16_t crc);
+	static uint16_t calculate(const uint8_t* data, size_t len);
+	static constexpr uint16_t compute(const uint8_t* data, size_t len) {
+		uint16_t crc = CRC16_INIT;
+		for (size_t idx = 0; idx < len; idx++) {
+			crc ^= data[idx];
+			for (uint8_t bit = 0; bit < 8; bit++) {
+				crc = (crc & 0x0001) ? (crc >> 1) ^ CRC16_POLY : crc >> 1;
+			}
+		}
+		return crc ^ CRC16_XOR_OUT;
+	}
+};
@@ -18,11 +18,6 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 
 #include "data-frames.hpp"
 
-RequestData::RequestData(uint8_t code, float multiplier)
-    : code(code)
-    , multiplier(multiplier) {
-}
-
 DataReqFrame::DataReqFrame(uint8_t requestCode)
     : EstiaFrame::EstiaFrame(FRAME_TYPE_REQ_DATA, FRAME_REQ_DATA_LEN)
     , requestCode(requestCode) {
@@ -35,8 +30,8 @@ DataReqFrame::DataReqFrame(uint8_t requestCode)
 	setByte(REQ_DATA_CODE_OFFSET, requestCode, true);
 }
 
-DataResFrame::DataResFrame(FrameBuffer&& buffer)
-    : EstiaFrame::EstiaFrame(buffer, FRAME_RES_DATA_LEN)
+DataResFrame::DataResFrame(const FrameView& buffer)
+    : ReceivedFrame::ReceivedFrame(buffer, FRAME_RES_DATA_LEN)
     , error(0)
     , value(0) {
 	error = checkFrame();
@@ -46,15 +41,11 @@ DataResFrame::DataResFrame(FrameBuffer&& buffer)
 }
 
 DataResFrame::DataResFrame(FrameBuffer& buffer)
-    : DataResFrame::DataResFrame(std::forward<FrameBuffer>(buffer)) {
-}
-
-DataResFrame::DataResFrame(ReadBuffer& buffer)
-    : DataResFrame::DataResFrame(readBuffToFrameBuff(buffer)) {
+    : DataResFrame::DataResFrame(FrameView(buffer)) {
 }
 
 uint8_t DataResFrame::checkFrame() {
-	uint8_t error = EstiaFrame::checkFrame(FRAME_TYPE_RES_DATA, FRAME_DATA_TYPE_DATA_RESPONSE);
+	uint8_t error = ReceivedFrame::checkFrame(FRAME_TYPE_RES_DATA, FRAME_DATA_TYPE_DATA_RESPONSE);
 	if (error != err_ok) { return error; }
 
 	if (readUint16(RES_DATA_EMPTY_OFFSET) == RES_DATA_FLAG_EMPTY) { return err_data_empty; }
@@ -19,22 +19,15 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include "frame.hpp"
-#include <string>
-#include <unordered_map>
-#include <utility>
-
-struct RequestData {
-	RequestData(uint8_t code, float multiplier);
-	uint8_t code;
-	float multiplier;
-};
+#include "name-catalog.hpp"
+
+#define REQUESTS_COUNT 33    // named data codes
 
 /**
 * @param name requested data name
 * @param code data code
-* @param multiplier data modifier
 */
-using RequestsMap = std::unordered_map<std::string, RequestData>;
+using RequestsMap = NameCatalog<uint8_t, REQUESTS_COUNT>;
 
 #define REQ_DATA_SRC FRAME_SRC_DST_REMOTE
 #define REQ_DATA_DST FRAME_SRC_DST_MASTER
@@ -92,45 +85,8 @@ enum RequestCode {
 	CODE_BOOST_HEATER_ON_TIME = 0xf7,     // x1/100 h boosterEHeaterAccumulationTime
 };
 
-/**
-* @param name requested data name
-* @param code data code
-* @param multiplier data modifier
-*/
-const RequestsMap requestsMap = {
-    {"tc", {CODE_TC, 1}},
-    {"twi", {CODE_TWI, 1}},
-    {"two", {CODE_TWO, 1}},
-    {"tho", {CODE_THO, 1}},
-    {"tfi", {CODE_TFI, 1}},
-    {"ttw", {CODE_TTW, 1}},
-    {"mix", {CODE_MIX, 1}},
-    {"lps", {CODE_LPS, 10}},
-    {"sw_ver", {CODE_SW_VER, 1}},
-    {"ctrl_hw_temp", {CODE_CTRL_HW_TEMP, 1}},
-    {"ctrl_zone1_temp", {CODE_CTRL_ZONE1_TEMP, 1}},
-    {"ctrl_zone2_temp", {CODE_CTRL_ZONE2_TEMP, 1}},
-    {"wf", {CODE_WF, 0.1F}},
-    {"te", {CODE_TE, 1}},
-    {"to", {CODE_TO, 1}},
-    {"td", {CODE_TD, 1}},
-    {"ts", {CODE_TS, 1}},
-    {"ths", {CODE_THS, 1}},
-    {"ct", {CODE_CT, 10}},
-    {"tl", {CODE_TL, 1}},
-    {"cmp", {CODE_CMP, 1}},
-    {"fan1", {CODE_FAN1, 1}},
-    {"fan2", {CODE_FAN2, 1}},
-    {"pmv", {CODE_PMV, 10}},
-    {"hps", {CODE_HPS, 10}},
-    {"hp_on_time", {CODE_HP_ON_TIME, 100}},
-    {"hw_cmp_on_time", {CODE_HW_CMP_ON_TIME, 100}},
-    {"cool_cmp_on_time", {CODE_COOL_CMP_ON_TIME, 100}},
-    {"heat_cmp_on_time", {CODE_HEAT_CMP_ON_TIME, 100}},
-    {"pump1_on_time", {CODE_PUMP1_ON_TIME, 100}},
-    {"hw_e_heater_on_time", {CODE_HW_E_HEATER_ON_TIME, 100}},
-    {"backup_heater_on_time", {CODE_BACKUP_HEATER_ON_TIME, 100}},
-    {"boost_heater_on_time", {CODE_BOOST_HEATER_ON_TIME, 100}}};
+// data name to code, generated from sensors descriptor table (sensor-store.cpp)
+extern const RequestsMap requestsMap;
 
 #define RES_DATA_SRC FRAME_SRC_DST_MASTER
 #define RES_DATA_DST FRAME_SRC_DST_REMOTE
@@ -139,7 +95,7 @@ const RequestsMap requestsMap = {
 #define RES_DATA_FLAG_EMPTY 0x00a2
 #define RES_DATA_FLAG_NOT_EMPTY 0x002c
 
-class DataResFrame : public EstiaFrame {
+class DataResFrame : public ReceivedFrame {
   private:
 	uint8_t checkFrame();
 
@@ -148,9 +104,10 @@ class DataResFrame : public EstiaFrame {
 		err_data_empty = err_other,
 	};
 
-	DataResFrame(FrameBuffer&& buffer);
+	DataResFrame(const FrameView& buffer);
 	DataResFrame(FrameBuffer& buffer);
-	DataResFrame(ReadBuffer& buffer);
+	DataResFrame(FrameBuffer&& buffer) = delete;    // frame is not copied, view would dangle
+	DataResFrame(ReadBuffer& buffer) = delete;
 
 	uint8_t error;
 	int16_t value;
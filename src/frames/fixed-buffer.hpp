@@ -0,0 +1,169 @@
+/*
+fixed-buffer.hpp - Estia R32 heat pump fixed capacity frame buffer
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <initializer_list>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if __cpp_exceptions
+#include <stdexcept>
+#endif
+
+/** Inline byte buffer with `std::vector` like interface and no heap use.
+*
+* Writes past `Capacity` are dropped, `resize()` is clamped to `Capacity`.
+* @tparam Capacity maximum buffer length
+*/
+template <size_t Capacity>
+class FixedBuffer {
+	static_assert(Capacity <= UINT8_MAX, "FixedBuffer length is stored in uint8_t");
+
+  private:
+	uint8_t buffer[Capacity];
+	uint8_t length;
+
+	static void outOfRange() {
+#if __cpp_exceptions
+		throw std::out_of_range("FixedBuffer");
+#else
+		abort();
+#endif
+	}
+
+  public:
+	using value_type = uint8_t;
+	using size_type = size_t;
+	using reference = uint8_t&;
+	using const_reference = const uint8_t&;
+	using iterator = uint8_t*;
+	using const_iterator = const uint8_t*;
+
+	FixedBuffer()
+	    : length(0) {
+	}
+	FixedBuffer(size_t count, uint8_t value)
+	    : length(0) {
+		resize(count, value);
+	}
+	template <typename InputIt>
+	FixedBuffer(InputIt first, InputIt last)
+	    : length(0) {
+		assign(first, last);
+	}
+	FixedBuffer(std::initializer_list<uint8_t> bytes)
+	    : length(0) {
+		assign(bytes.begin(), bytes.end());
+	}
+	FixedBuffer(const FixedBuffer& other)
+	    : length(other.length) {
+		memcpy(buffer, other.buffer, length);
+	}
+	FixedBuffer& operator=(const FixedBuffer& other) {
+		length = other.length;
+		memmove(buffer, other.buffer, length);
+		return *this;
+	}
+
+	template <typename InputIt>
+	void assign(InputIt first, InputIt last) {
+		length = 0;
+		for (; first != last && length < Capacity; ++first) {
+			buffer[length++] = *first;
+		}
+	}
+
+	uint8_t& at(size_t idx) {
+		if (idx >= length) { outOfRange(); }
+		return buffer[idx];
+	}
+	const uint8_t& at(size_t idx) const {
+		if (idx >= length) { outOfRange(); }
+		return buffer[idx];
+	}
+	uint8_t& operator[](size_t idx) { return buffer[idx]; }
+	const uint8_t& operator[](size_t idx) const { return buffer[idx]; }
+	uint8_t& front() { return buffer[0]; }
+	const uint8_t& front() const { return buffer[0]; }
+	uint8_t& back() { return buffer[length - 1]; }
+	const uint8_t& back() const { return buffer[length - 1]; }
+	uint8_t* data() { return buffer; }
+	const uint8_t* data() const { return buffer; }
+
+	iterator begin() { return buffer; }
+	const_iterator begin() const { return buffer; }
+	iterator end() { return buffer + length; }
+	const_iterator end() const { return buffer + length; }
+
+	bool empty() const { return length == 0; }
+	bool full() const { return length == Capacity; }
+	size_t size() const { return length; }
+	static constexpr size_t capacity() { return Capacity; }
+	static constexpr size_t max_size() { return Capacity; }
+	void reserve(size_t) {}
+
+	void clear() { length = 0; }
+	void push_back(uint8_t value) {
+		if (length < Capacity) { buffer[length++] = value; }
+	}
+	void pop_back() {
+		if (length > 0) { length--; }
+	}
+	void resize(size_t count, uint8_t value = 0x00) {
+		if (count > Capacity) { count = Capacity; }
+		if (count > length) { memset(buffer + length, value, count - length); }
+		length = count;
+	}
+	iterator insert(const_iterator pos, uint8_t value) {
+		return insert(pos, {value});
+	}
+	// bytes moved past `Capacity` are dropped
+	iterator insert(const_iterator pos, std::initializer_list<uint8_t> bytes) {
+		size_t offset = pos - buffer;
+		size_t count = bytes.size();
+		if (offset > length) { offset = length; }
+		if (offset + count > Capacity) { count = Capacity - offset; }
+		size_t tail = length - offset;
+		if (offset + count + tail > Capacity) { tail = Capacity - offset - count; }
+		memmove(buffer + offset + count, buffer + offset, tail);
+		memcpy(buffer + offset, bytes.begin(), count);
+		length = offset + count + tail;
+		return buffer + offset;
+	}
+	iterator erase(const_iterator first, const_iterator last) {
+		size_t offset = first - buffer;
+		size_t count = last - first;
+		memmove(buffer + offset, buffer + offset + count, length - offset - count);
+		length -= count;
+		return buffer + offset;
+	}
+	void swap(FixedBuffer& other) {
+		FixedBuffer temp(other);
+		other = *this;
+		*this = temp;
+	}
+
+	bool operator==(const FixedBuffer& other) const {
+		return length == other.length && memcmp(buffer, other.buffer, length) == 0;
+	}
+	bool operator!=(const FixedBuffer& other) const {
+		return !(*this == other);
+	}
+};
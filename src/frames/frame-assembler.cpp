@@ -0,0 +1,204 @@
+/*
+frame-assembler.cpp - Estia R32 heat pump incremental frame assembly
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "frame-assembler.hpp"
+
+#define FRAME_BEGIN_HIGH (FRAME_BEGIN >> 8)
+#define FRAME_BEGIN_LOW (FRAME_BEGIN & 0xff)
+
+FrameAssembler::FrameAssembler()
+    : frame()
+    , state(asm_idle)
+    , frameSize(0)
+    , crc(Crc16::init())
+    , idleGap(0)
+    , exactTimes(true)
+    , lastByteTime(0)
+    , frameEndTime(0)
+    , frameHandler(nullptr) {
+}
+
+/** Feed one received byte.
+*
+* @return number of frames appended to `frames`
+*/
+size_t FrameAssembler::push(uint8_t byte, AssembledFrames& frames) {
+	size_t completed = 0;
+	frame.push_back(byte);
+	if (frame.size() > 2) { crc = Crc16::update(crc, frame[frame.size() - 3]); }
+
+	switch (state) {
+	case asm_idle:
+		state = byte == FRAME_BEGIN_HIGH ? asm_header : asm_unsynced;
+		break;
+
+	case asm_header:
+		if (frame.size() == 2 && byte != FRAME_BEGIN_LOW) {
+			state = asm_unsynced;
+			break;
+		}
+		if (frame.size() == FRAME_HEAD_LEN) {
+			frameSize = byte + FRAME_HEAD_AND_CRC_LEN;
+			// data length out of range, frame will be closed by next frame begin
+			state = frameSize >= FRAME_MIN_LEN && frameSize <= FRAME_MAX_LEN ? asm_body : asm_unsynced;
+		}
+		break;
+
+	case asm_body:
+		// frame data may contain 0xa0 0x00, rely on data length only
+		if (frame.size() >= frameSize) { completed += complete(frames); }
+		break;
+
+	case asm_unsynced:
+		// next frame begin, pass malformed bytes to frame fixer
+		if (frame.size() > 2 && EstiaFrame::readUint16(frame, frame.size() - 2) == FRAME_BEGIN) {
+			frame.resize(frame.size() - 2);
+			completed += emit(frames);
+			frame.push_back(FRAME_BEGIN_HIGH);
+			frame.push_back(FRAME_BEGIN_LOW);
+			state = asm_header;
+		}
+		break;
+	}
+	if (state != asm_idle && frame.full()) { completed += flush(frames); }
+	return completed;
+}
+
+size_t FrameAssembler::push(const uint8_t* data, size_t len, AssembledFrames& frames) {
+	size_t completed = 0;
+	for (size_t idx = 0; idx < len; idx++) {
+		completed += push(data[idx], frames);
+	}
+	return completed;
+}
+
+/** Feed one received byte with its receive time.
+*
+* @param time receive time (us), read time when times are not exact (`setExactTimes()`)
+* @return number of frames appended to `frames`
+*/
+size_t FrameAssembler::push(uint8_t byte, uint32_t time, AssembledFrames& frames) {
+	size_t completed = 0;
+	// line was idle before this byte, previous frame has ended
+	if (exactTimes && idleGap != 0 && state != asm_idle && time - lastByteTime > idleGap) {
+		completed += flush(frames);
+	}
+	lastByteTime = time;
+	return completed + push(byte, frames);
+}
+
+size_t FrameAssembler::push(const uint8_t* data, const uint32_t* times, size_t len, AssembledFrames& frames) {
+	size_t completed = 0;
+	for (size_t idx = 0; idx < len; idx++) {
+		completed += push(data[idx], times[idx], frames);
+	}
+	return completed;
+}
+
+/** Close frame when line is silent longer than idle gap.
+*
+* @param idleTime time (us) since last byte was received
+* @return number of frames appended to `frames`
+*/
+size_t FrameAssembler::idle(uint32_t idleTime, AssembledFrames& frames) {
+	if (idleGap == 0 || state == asm_idle || idleTime <= idleGap) { return 0; }
+
+	return flush(frames);
+}
+
+/** @param gap line silence (us) closing frame, `0` frames are split by length only */
+void FrameAssembler::setIdleGap(uint32_t gap) {
+	idleGap = gap;
+}
+
+uint32_t FrameAssembler::getIdleGap() const {
+	return idleGap;
+}
+
+/** @param exact `false` bytes are read in chunks (loop delays), times only give frame end time,
+* gap between chunks is not line silence and frames are closed by `idle()` only
+*/
+void FrameAssembler::setExactTimes(bool exact) {
+	exactTimes = exact;
+}
+
+/** @return last byte receive time (us) of last completed frame */
+uint32_t FrameAssembler::getFrameEndTime() const {
+	return frameEndTime;
+}
+
+/** Handler is called with every completed frame and its CRC state before it is queued, also when queue drops it.
+*
+* Frame may be modified (fixed) by handler, queue gets modified frame.
+*/
+void FrameAssembler::onFrame(AssembledFrameHandler handler) {
+	frameHandler = handler;
+}
+
+/** Close collected bytes as frame (bus idle).
+*
+* @return number of frames appended to `frames`
+*/
+size_t FrameAssembler::flush(AssembledFrames& frames) {
+	if (frame.empty()) { return 0; }
+
+	return emit(frames);
+}
+
+void FrameAssembler::reset() {
+	frame.clear();
+	state = asm_idle;
+	frameSize = 0;
+	crc = Crc16::init();
+}
+
+bool FrameAssembler::busy() const {
+	return state != asm_idle;
+}
+
+FrameAssembler::State FrameAssembler::getState() const {
+	return state;
+}
+
+size_t FrameAssembler::complete(AssembledFrames& frames) {
+	if (Crc16::finalize(crc) == EstiaFrame::readUint16(frame, frame.size() - 2)) { return emit(frames, FrameView::crc_valid); }
+
+	// check for joined two frames (first one is missing bytes), next frame begin may be last byte
+	uint8_t idx = 1;
+	for (; idx < frame.size(); idx++) {
+		if (frame.at(idx) != FRAME_BEGIN_HIGH) { continue; }
+		if (idx + 1U == frame.size() || frame.at(idx + 1) == FRAME_BEGIN_LOW) { break; }
+	}
+	if (idx == frame.size()) { return emit(frames, FrameView::crc_invalid); }
+
+	FrameBuffer next(frame.begin() + idx, frame.end());
+	frame.resize(idx);
+	size_t completed = emit(frames);
+	return completed + push(next.data(), next.size(), frames);
+}
+
+/** @param crcState CRC checked by `complete()`, unchecked for frames closed by idle gap or next frame begin
+* @return number of frames queued, frame is dropped when there is no free slot
+*/
+size_t FrameAssembler::emit(AssembledFrames& frames, FrameView::CrcState crcState) {
+	frameEndTime = lastByteTime;
+	if (frameHandler) { frameHandler(frame, crcState); }
+	size_t queued = frames.push_back(frame) ? 1 : 0;
+	reset();
+	return queued;
+}
@@ -0,0 +1,76 @@
+/*
+frame-assembler.hpp - Estia R32 heat pump incremental frame assembly
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "frame-pool.hpp"
+#include <functional>
+
+using AssembledFrames = FramePool;
+using AssembledFrameHandler = std::function<void(FrameBuffer& frame, FrameView::CrcState crc)>;
+
+/** Byte driven frame splitter.
+*
+* Consumes bytes as they arrive and keeps its position between calls
+* (hunting for `0xa0 0x00`, header, body by data length), never waits for data.
+* With idle gap set, frame is also closed when line is silent longer than gap
+* (byte times when they are exact receive times, otherwise `idle()` only).
+* CRC is updated as bytes arrive and checked once when frame is complete, result is passed with frame.
+* Completed frames are passed to handler (`onFrame()`) and appended to output queue.
+*/
+class FrameAssembler {
+  public:
+	enum State : uint8_t {
+		asm_idle,        // no bytes collected
+		asm_header,      // frame begin received, waiting for data length
+		asm_body,        // waiting for data and CRC
+		asm_unsynced,    // no valid header, collect up to next frame begin
+	};
+
+  private:
+	FrameBuffer frame;
+	State state;
+	uint8_t frameSize;
+	uint16_t crc;    // over bytes before last two (frame CRC)
+	uint32_t idleGap;
+	bool exactTimes;    // byte times are receive times, gap between them is line silence
+	uint32_t lastByteTime;
+	uint32_t frameEndTime;
+	AssembledFrameHandler frameHandler;
+
+	size_t complete(AssembledFrames& frames);
+	size_t emit(AssembledFrames& frames, FrameView::CrcState crcState = FrameView::crc_unchecked);
+
+  public:
+	FrameAssembler();
+
+	size_t push(uint8_t byte, AssembledFrames& frames);
+	size_t push(const uint8_t* data, size_t len, AssembledFrames& frames);
+	size_t push(uint8_t byte, uint32_t time, AssembledFrames& frames);
+	size_t push(const uint8_t* data, const uint32_t* times, size_t len, AssembledFrames& frames);
+	size_t idle(uint32_t idleTime, AssembledFrames& frames);
+	void setIdleGap(uint32_t gap);
+	uint32_t getIdleGap() const;
+	void setExactTimes(bool exact);
+	uint32_t getFrameEndTime() const;
+	void onFrame(AssembledFrameHandler handler);
+	size_t flush(AssembledFrames& frames);
+	void reset();
+	bool busy() const;
+	State getState() const;
+};
@@ -0,0 +1,62 @@
+/*
+frame-classifier.cpp - Estia R32 heat pump received frames classification
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "frame-classifier.hpp"
+
+struct FrameKindTable {
+	FrameClassifier::Entry slots[FRAME_KIND_SLOTS];
+	bool collision;
+
+	constexpr FrameKindTable()
+	    : slots()
+	    , collision(false) {
+		for (FrameClassifier::Entry& slot : slots) {
+			slot = {0x00, 0x00, 0x0000, FrameClassifier::frame_unknown};
+		}
+		add({FRAME_TYPE_CTRL_FRAME, FRAME_HEARTBEAT_DATA_LEN, FRAME_DATA_TYPE_HEARTBEAT, FrameClassifier::frame_heartbeat});
+		add({FRAME_TYPE_STATUS, FRAME_STATUS_DATA_LEN, FRAME_DATA_TYPE_STATUS, FrameClassifier::frame_status});
+		add({FRAME_TYPE_STATUS, FRAME_SHORT_STATUS_DATA_LEN, FRAME_DATA_TYPE_SHORT_STATUS, FrameClassifier::frame_short_status});
+		add({FRAME_TYPE_UPDATE, FRAME_UPDATE_DATA_LEN, FRAME_DATA_TYPE_STATUS, FrameClassifier::frame_status_update});
+		add({FRAME_TYPE_STATUS2, FRAME_STATUS2_DATA_LEN, FRAME_DATA_TYPE_STATUS, FrameClassifier::frame_remote_status});
+		add({FRAME_TYPE_REQ_DATA, FRAME_REQ_DATA_DATA_LEN, FRAME_DATA_TYPE_DATA_REQUEST, FrameClassifier::frame_data_request});
+		add({FRAME_TYPE_RES_DATA, FRAME_RES_DATA_DATA_LEN, FRAME_DATA_TYPE_DATA_RESPONSE, FrameClassifier::frame_data_response});
+		add({FRAME_TYPE_ACK, FRAME_ACK_DATA_LEN, FRAME_DATA_TYPE_ACK, FrameClassifier::frame_ack});
+	}
+	constexpr void add(FrameClassifier::Entry entry) {
+		FrameClassifier::Entry& slot = slots[FrameClassifier::slot(entry.type, entry.dataLength)];
+		if (slot.kind != FrameClassifier::frame_unknown) { collision = true; }
+		slot = entry;
+	}
+};
+
+static constexpr FrameKindTable frameKinds PROGMEM = FrameKindTable();
+static_assert(!frameKinds.collision, "frame kinds slot collision, change FrameClassifier::slot()");
+
+FrameClassifier::FrameKind FrameClassifier::classify(const FrameView& frame) {
+	if (frame.size() < FRAME_MIN_LEN || frame[0] != FRAME_BEGIN >> 8 || frame[1] != (FRAME_BEGIN & 0xff)) { return frame_unknown; }
+
+	uint8_t type = frame[FRAME_TYPE_OFFSET];
+	uint8_t dataLength = frame[FRAME_DATA_LEN_OFFSET];
+	if (frame.size() != static_cast<size_t>(dataLength + FRAME_HEAD_AND_CRC_LEN)) { return frame_unknown; }
+
+	Entry entry;
+	memcpy_P(&entry, &frameKinds.slots[slot(type, dataLength)], sizeof(Entry));
+	if (entry.type != type || entry.dataLength != dataLength) { return frame_unknown; }
+	if (entry.dataType != (frame[FRAME_DATA_TYPE_OFFSET] << 8 | frame[FRAME_DATA_TYPE_OFFSET + 1])) { return frame_unknown; }
+	return entry.kind;
+}
@@ -0,0 +1,56 @@
+/*
+frame-classifier.hpp - Estia R32 heat pump received frames classification
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "frame.hpp"
+
+#define FRAME_KIND_SLOTS 16    // power of 2
+
+/** Single pass frame classification.
+*
+* Header is read once and (frame type, data length, data type) is looked up
+* in a hashed table (flash), no matter how many frame kinds are known.
+*/
+class FrameClassifier {
+  public:
+	enum FrameKind : uint8_t {
+		frame_unknown,
+		frame_heartbeat,
+		frame_status,
+		frame_short_status,
+		frame_status_update,
+		frame_remote_status,
+		frame_data_request,
+		frame_data_response,
+		frame_ack,
+		frame_kinds_count,
+	};
+
+	struct Entry {
+		uint8_t type;
+		uint8_t dataLength;
+		uint16_t dataType;
+		FrameKind kind;
+	};
+
+	static constexpr uint8_t slot(uint8_t type, uint8_t dataLength) {
+		return ((type >> 3) + dataLength) & (FRAME_KIND_SLOTS - 1);
+	}
+	static FrameKind classify(const FrameView& frame);
+};
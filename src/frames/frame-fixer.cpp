@@ -41,14 +41,15 @@ KnownFrame::KnownFrame(uint8_t frameType, uint8_t dataLen, uint16_t src, uint16_
 FrameFixer::FrameFixer()
     : fixedBuffer()
     , crc() {
-	fixedBuffer.reserve(FRAME_MAX_LEN);
 }
 
-bool FrameFixer::fixFrame(FrameBuffer& buffer) {
+/** @param crcState `FrameView::crc_invalid` frame CRC already checked (assembler), not calculated again */
+bool FrameFixer::fixFrame(FrameBuffer& buffer, FrameView::CrcState crcState) {
 	if (buffer.size() < FRAME_MIN_LEN - 2) { return false; }
 
 	this->crc = EstiaFrame::readUint16(buffer, buffer.size() - 2);
-	if (crc == EstiaFrame::crc16(buffer.data(), buffer.size() - 2)) { return true; }
+	if (crcState == FrameView::crc_valid) { return true; }
+	if (crcState == FrameView::crc_unchecked && crc == Crc16::calculate(buffer.data(), buffer.size() - 2)) { return true; }
 
 	this->fixedBuffer = buffer;
 
@@ -86,17 +87,21 @@ bool FrameFixer::fixFrame(FrameBuffer& buffer) {
 	return false;
 };
 
+bool FrameFixer::crcMatches() {
+	return crc == Crc16::calculate(fixedBuffer.data(), fixedBuffer.size() - 2);
+}
+
 bool FrameFixer::addMissingBytes() {
 	if (EstiaFrame::readUint16(fixedBuffer, 0) == FRAME_BEGIN) { return false; }
 
 	for (auto& frame : knownFrames) {
 		if (fixedBuffer.front() == 0x00 && fixedBuffer.size() == frame.len - 1) {
 			fixedBuffer.insert(fixedBuffer.begin(), 0xa0);
-			if (crc == EstiaFrame::crc16(fixedBuffer.data(), fixedBuffer.size() - 2)) { return true; }
+			if (crcMatches()) { return true; }
 			break;
 		} else if (fixedBuffer.front() == frame.frameType && fixedBuffer.size() == frame.len - 2) {
 			fixedBuffer.insert(fixedBuffer.begin(), {0xa0, 0x00});
-			if (crc == EstiaFrame::crc16(fixedBuffer.data(), fixedBuffer.size() - 2)) { return true; }
+			if (crcMatches()) { return true; }
 			break;
 		}
 	}
@@ -107,14 +112,14 @@ bool FrameFixer::fixDataLength() {
 	if (fixedBuffer.at(FRAME_DATA_LEN_OFFSET) + FRAME_HEAD_AND_CRC_LEN == fixedBuffer.size()) { return false; }
 
 	fixedBuffer.at(FRAME_DATA_LEN_OFFSET) = fixedBuffer.size() - FRAME_HEAD_AND_CRC_LEN;
-	if (crc == EstiaFrame::crc16(fixedBuffer.data(), fixedBuffer.size() - 2)) { return true; }
+	if (crcMatches()) { return true; }
 	return false;
 }
 
 bool FrameFixer::fixStaticBytes() {
 	EstiaFrame::writeUint16(fixedBuffer, 0, FRAME_BEGIN);
 	fixedBuffer.at(FRAME_DATA_HEADER_OFFSET) == 0x00;
-	if (crc == EstiaFrame::crc16(fixedBuffer.data(), fixedBuffer.size() - 2)) { return true; }
+	if (crcMatches()) { return true; }
 	return false;
 }
 
@@ -122,7 +127,7 @@ bool FrameFixer::fixFrameType(const KnownFrame& frame) {
 	if (fixedBuffer.at(FRAME_TYPE_OFFSET) == frame.frameType) { return false; }
 
 	fixedBuffer.at(FRAME_TYPE_OFFSET) = frame.frameType;
-	if (crc == EstiaFrame::crc16(fixedBuffer.data(), fixedBuffer.size() - 2)) { return true; }
+	if (crcMatches()) { return true; }
 	return false;
 }
 
@@ -130,6 +135,6 @@ bool FrameFixer::fixDataHeader(const KnownFrame& frame) {
 	EstiaFrame::writeUint16(fixedBuffer, FRAME_SRC_OFFSET, frame.src);
 	EstiaFrame::writeUint16(fixedBuffer, FRAME_DST_OFFSET, frame.dst);
 	EstiaFrame::writeUint16(fixedBuffer, FRAME_DATA_TYPE_OFFSET, frame.dataType);
-	if (crc == EstiaFrame::crc16(fixedBuffer.data(), fixedBuffer.size() - 2)) { return true; }
+	if (crcMatches()) { return true; }
 	return false;
 }
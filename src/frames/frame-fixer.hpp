@@ -36,6 +36,7 @@ using KnownFrames = std::vector<KnownFrame>;
 
 class FrameFixer {
   private:
+	bool crcMatches();
 	bool addMissingBytes();
 	bool fixDataLength();
 	bool fixStaticBytes();
@@ -48,5 +49,5 @@ class FrameFixer {
   public:
 	FrameFixer();
 
-	bool fixFrame(FrameBuffer& buffer);
+	bool fixFrame(FrameBuffer& buffer, FrameView::CrcState crcState = FrameView::crc_unchecked);
 };
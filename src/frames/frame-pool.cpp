@@ -0,0 +1,194 @@
+/*
+frame-pool.cpp - Estia R32 heat pump preallocated sniffed frames pool
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "frame-pool.hpp"
+
+FrameHandle::FrameHandle()
+    : pool(nullptr)
+    , slot(0) {
+}
+
+FrameHandle::FrameHandle(FramePool* pool, uint8_t slot)
+    : pool(pool)
+    , slot(slot) {
+}
+
+FrameHandle::FrameHandle(FrameHandle&& other)
+    : pool(other.pool)
+    , slot(other.slot) {
+	other.pool = nullptr;
+}
+
+FrameHandle::~FrameHandle() {
+	release();
+}
+
+FrameHandle& FrameHandle::operator=(FrameHandle&& other) {
+	if (this != &other) {
+		release();
+		pool = other.pool;
+		slot = other.slot;
+		other.pool = nullptr;
+	}
+	return *this;
+}
+
+// return slot to pool
+void FrameHandle::release() {
+	if (!pool) { return; }
+
+	pool->release(slot);
+	pool = nullptr;
+}
+
+bool FrameHandle::valid() const {
+	return pool != nullptr;
+}
+
+// empty frame for invalid handle
+const FrameBuffer& FrameHandle::buffer() const {
+	static const FrameBuffer emptyFrame;
+	return pool ? pool->slot(slot) : emptyFrame;
+}
+
+FrameView FrameHandle::view() const {
+	return FrameView(buffer());
+}
+
+FramePool::FramePool()
+    : slots(nullptr)
+    , queue(nullptr)
+    , freeSlots(nullptr)
+    , capacity(0)
+    , head(0)
+    , count(0)
+    , freeCount(0)
+    , dropped(0) {
+}
+
+FramePool::~FramePool() {
+	delete[] slots;
+	delete[] queue;
+	delete[] freeSlots;
+}
+
+/** Allocate slots, only first call allocates.
+*
+* @param capacity number of frame slots
+*/
+bool FramePool::allocate(uint8_t capacity) {
+	if (slots) { return true; }
+	if (capacity == 0) { return false; }
+
+	slots = new FrameBuffer[capacity];
+	queue = new uint8_t[capacity];
+	freeSlots = new uint8_t[capacity];
+	this->capacity = capacity;
+	for (uint8_t idx = 0; idx < capacity; idx++) {
+		freeSlots[idx] = capacity - 1 - idx;
+	}
+	freeCount = capacity;
+	return true;
+}
+
+/** Copy frame to free slot (or oldest queued) and queue it.
+*
+* @return `false` frame dropped, no slot available
+*/
+bool FramePool::push_back(const FrameBuffer& frame) {
+	uint8_t slot;
+	if (freeCount != 0) {
+		slot = freeSlots[--freeCount];
+	} else if (count != 0) {
+		// overwrite oldest queued frame
+		slot = queue[head];
+		head = (head + 1) % capacity;
+		count--;
+		dropped++;
+	} else {
+		dropped++;
+		return false;
+	}
+	slots[slot] = frame;
+	queue[(head + count) % capacity] = slot;
+	count++;
+	return true;
+}
+
+/** Move oldest queued frame out of queue, slot stays in use until handle is released. */
+FrameHandle FramePool::take() {
+	if (count == 0) { return FrameHandle(); }
+
+	uint8_t slot = queue[head];
+	head = (head + 1) % capacity;
+	count--;
+	return FrameHandle(this, slot);
+}
+
+void FramePool::release(uint8_t slot) {
+	slots[slot].clear();
+	freeSlots[freeCount++] = slot;
+}
+
+FrameBuffer& FramePool::slot(uint8_t slot) {
+	return slots[slot];
+}
+
+uint8_t FramePool::queued(size_t idx) const {
+	return queue[(head + idx) % capacity];
+}
+
+FrameBuffer& FramePool::operator[](size_t idx) {
+	return slots[queued(idx)];
+}
+
+FrameBuffer& FramePool::front() {
+	return slots[queued(0)];
+}
+
+void FramePool::pop_front() {
+	if (count == 0) { return; }
+
+	uint8_t slot = queue[head];
+	head = (head + 1) % capacity;
+	count--;
+	release(slot);
+}
+
+void FramePool::clear() {
+	while (count != 0) {
+		pop_front();
+	}
+}
+
+size_t FramePool::size() const {
+	return count;
+}
+
+bool FramePool::empty() const {
+	return count == 0;
+}
+
+// free slots
+size_t FramePool::available() const {
+	return freeCount;
+}
+
+uint32_t FramePool::drops() const {
+	return dropped;
+}
@@ -0,0 +1,98 @@
+/*
+frame-pool.hpp - Estia R32 heat pump preallocated sniffed frames pool
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "frame.hpp"
+
+class FramePool;
+
+/** Sniffed frame moved out of pool, slot returns to pool when handle is released or destroyed.
+*
+* Move only, no frame copy.
+*/
+class FrameHandle {
+  private:
+	FramePool* pool;
+	uint8_t slot;
+
+  public:
+	FrameHandle();
+	FrameHandle(FramePool* pool, uint8_t slot);
+	FrameHandle(FrameHandle&& other);
+	FrameHandle(const FrameHandle&) = delete;
+	~FrameHandle();
+
+	FrameHandle& operator=(FrameHandle&& other);
+	FrameHandle& operator=(const FrameHandle&) = delete;
+
+	void release();
+	bool valid() const;
+	explicit operator bool() const { return valid(); }
+	const FrameBuffer& buffer() const;
+	operator const FrameBuffer&() const { return buffer(); }
+	FrameView view() const;
+
+	const uint8_t* data() const { return buffer().data(); }
+	size_t size() const { return buffer().size(); }
+	bool empty() const { return buffer().empty(); }
+	const uint8_t& at(size_t idx) const { return buffer().at(idx); }
+	const uint8_t& operator[](size_t idx) const { return buffer()[idx]; }
+	const uint8_t* begin() const { return buffer().begin(); }
+	const uint8_t* end() const { return buffer().end(); }
+};
+
+/** Fixed number of frame slots allocated once (`allocate()`), used as FIFO queue.
+*
+* When all slots are used oldest queued frame is overwritten,
+* if all slots are moved out to handles new frame is dropped.
+*/
+class FramePool {
+  private:
+	FrameBuffer* slots;
+	uint8_t* queue;        // queued slots ring
+	uint8_t* freeSlots;    // free slots stack
+	uint8_t capacity;
+	uint8_t head;
+	uint8_t count;
+	uint8_t freeCount;
+	uint32_t dropped;
+
+	uint8_t queued(size_t idx) const;
+
+  public:
+	FramePool();
+	~FramePool();
+	FramePool(const FramePool&) = delete;
+	FramePool& operator=(const FramePool&) = delete;
+
+	bool allocate(uint8_t capacity);
+	bool push_back(const FrameBuffer& frame);
+	FrameHandle take();
+	void release(uint8_t slot);
+	FrameBuffer& slot(uint8_t slot);
+
+	FrameBuffer& operator[](size_t idx);
+	FrameBuffer& front();
+	void pop_front();
+	void clear();
+	size_t size() const;
+	bool empty() const;
+	size_t available() const;
+	uint32_t drops() const;
+};
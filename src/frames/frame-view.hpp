@@ -0,0 +1,89 @@
+/*
+frame-view.hpp - Estia R32 heat pump read only frame view
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#if __cpp_exceptions
+#include <stdexcept>
+#endif
+
+/** Read only, non owning view of contiguous frame bytes (pointer + length).
+*
+* View is valid as long as viewed buffer is.
+* Carries CRC state so frame checked once (e.g. by FrameFixer) is not checked again.
+*/
+class FrameView {
+  public:
+	enum CrcState : uint8_t {
+		crc_unchecked,
+		crc_valid,
+		crc_invalid,
+	};
+
+	using value_type = uint8_t;
+	using size_type = size_t;
+	using const_reference = const uint8_t&;
+	using const_iterator = const uint8_t*;
+
+  private:
+	const uint8_t* buffer;
+	uint8_t length;
+	CrcState crcState;
+
+  public:
+	FrameView()
+	    : buffer(nullptr)
+	    , length(0)
+	    , crcState(crc_unchecked) {
+	}
+	FrameView(const uint8_t* data, size_t size, CrcState crcState = crc_unchecked)
+	    : buffer(data)
+	    , length(size)
+	    , crcState(crcState) {
+	}
+	template <typename Buffer>
+	FrameView(const Buffer& buffer, CrcState crcState = crc_unchecked)
+	    : FrameView(buffer.data(), buffer.size(), crcState) {
+	}
+
+	const uint8_t& at(size_t idx) const {
+		if (idx >= length) {
+#if __cpp_exceptions
+			throw std::out_of_range("FrameView");
+#else
+			abort();
+#endif
+		}
+		return buffer[idx];
+	}
+	const uint8_t& operator[](size_t idx) const { return buffer[idx]; }
+	const uint8_t& front() const { return buffer[0]; }
+	const uint8_t& back() const { return buffer[length - 1]; }
+	const uint8_t* data() const { return buffer; }
+	const_iterator begin() const { return buffer; }
+	const_iterator end() const { return buffer + length; }
+	bool empty() const { return length == 0; }
+	size_t size() const { return length; }
+
+	CrcState crc() const { return crcState; }
+	bool crcVerified() const { return crcState == crc_valid; }
+	void setCrc(CrcState state) { crcState = state; }
+};
@@ -17,11 +17,12 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 */
 
 #include "frame.hpp"
+#include "frame-pool.hpp"
 
 // frame from buffer (rvalue)
 EstiaFrame::EstiaFrame(FrameBuffer&& buffer, uint8_t length)
-    : length(length)
-    , buffer(buffer)
+    : buffer(std::move(buffer))
+    , length(length)
     , type(0x00)
     , dataLength(0x00)
     , src(0x0000)
@@ -42,13 +43,13 @@ EstiaFrame::EstiaFrame(FrameBuffer&& buffer, uint8_t length)
 
 // frame from buffer (lvalue)
 EstiaFrame::EstiaFrame(FrameBuffer& buffer, uint8_t length)
-    : EstiaFrame::EstiaFrame(std::forward<FrameBuffer>(buffer), length) {
+    : EstiaFrame::EstiaFrame(FrameBuffer(buffer), length) {
 }
 
 // frame with type, empty data and no crc
 EstiaFrame::EstiaFrame(uint8_t type, uint8_t length)
-    : length(length)
-    , buffer(length, 0x00)
+    : buffer(length, 0x00)
+    , length(length)
     , type(type)
     , dataLength(length - FRAME_HEAD_AND_CRC_LEN)
     , src(0x0000)
@@ -64,6 +65,25 @@ EstiaFrame::EstiaFrame(uint8_t type, uint8_t length)
 	buffer.at(FRAME_DATA_LEN_OFFSET) = dataLength;
 }
 
+// frame from pre-encoded command, works for command stored in flash and in RAM
+EstiaFrame::EstiaFrame(const CommandFrame& frame)
+    : buffer(pgm_read_byte(&frame.length), 0x00)
+    , length(pgm_read_byte(&frame.length))
+    , type(0x00)
+    , dataLength(0x00)
+    , src(0x0000)
+    , dst(0x0000)
+    , dataType(0x0000)
+    , crc(0x0000) {
+	memcpy_P(buffer.data(), frame.bytes, buffer.size());
+	type = buffer.at(FRAME_TYPE_OFFSET);
+	dataLength = buffer.at(FRAME_DATA_LEN_OFFSET);
+	src = readUint16(FRAME_SRC_OFFSET);
+	dst = readUint16(FRAME_DST_OFFSET);
+	dataType = readUint16(FRAME_DATA_TYPE_OFFSET);
+	crc = readUint16(length - 2);
+}
+
 bool EstiaFrame::setByte(uint8_t offset, uint8_t value, bool updateCrc) {
 	if (offset >= length) { return false; }
 
@@ -81,7 +101,7 @@ uint8_t EstiaFrame::size() const {
 }
 
 void EstiaFrame::updateCrc() {
-	crc = crc16(buffer.data(), length - 2);
+	crc = Crc16::calculate(buffer.data(), length - 2);
 	writeUint16(length - 2, crc);
 }
 
@@ -98,12 +118,15 @@ String EstiaFrame::stringify() {
 	return stringify(this->buffer);
 }
 
+// thin wrapper over hexByte, single String allocation
 template <typename Buffer>
 String EstiaFrame::stringify(const Buffer& buffer) {
-	String stringifyBuffer = "";
+	String stringifyBuffer;
+	stringifyBuffer.reserve(buffer.size() * 3);
+	char hex[4] = {0x00, 0x00, ' ', 0x00};
 	for (auto& byte : buffer) {
-		if (byte < 0x10) { stringifyBuffer += "0"; }
-		stringifyBuffer += String(byte, HEX) + " ";
+		hexByte(byte, hex);
+		stringifyBuffer.concat(hex);
 	}
 	stringifyBuffer.trim();
 	return stringifyBuffer;
@@ -111,6 +134,60 @@ String EstiaFrame::stringify(const Buffer& buffer) {
 
 template String EstiaFrame::stringify<FrameBuffer>(const FrameBuffer& buffer);
 template String EstiaFrame::stringify<ReadBuffer>(const ReadBuffer& buffer);
+template String EstiaFrame::stringify<FrameView>(const FrameView& buffer);
+template String EstiaFrame::stringify<FrameHandle>(const FrameHandle& buffer);
+
+// two lowercase hex digits, no terminator
+char* EstiaFrame::hexByte(uint8_t byte, char* out) {
+	static const char digits[] = "0123456789abcdef";
+	out[0] = digits[byte >> 4];
+	out[1] = digits[byte & 0x0f];
+	return out + 2;
+}
+
+/** Write `a0 00 10 ...` to caller buffer, always null terminated.
+*
+* Output is truncated on whole bytes when `outSize` is too small (`size * 3` fits all).
+* @return number of characters written (without terminator)
+*/
+template <typename Buffer>
+size_t EstiaFrame::toHex(const Buffer& buffer, char* out, size_t outSize) {
+	if (!out || outSize == 0) { return 0; }
+
+	char* pos = out;
+	for (auto& byte : buffer) {
+		size_t needed = pos == out ? 3 : 4;    // [space] + 2 digits + terminator
+		if (static_cast<size_t>(pos - out) + needed > outSize) { break; }
+		if (pos != out) { *pos++ = ' '; }
+		pos = hexByte(byte, pos);
+	}
+	*pos = '\0';
+	return pos - out;
+}
+
+template size_t EstiaFrame::toHex<FrameBuffer>(const FrameBuffer& buffer, char* out, size_t outSize);
+template size_t EstiaFrame::toHex<ReadBuffer>(const ReadBuffer& buffer, char* out, size_t outSize);
+template size_t EstiaFrame::toHex<FrameView>(const FrameView& buffer, char* out, size_t outSize);
+template size_t EstiaFrame::toHex<FrameHandle>(const FrameHandle& buffer, char* out, size_t outSize);
+
+// hex straight to Print (e.g. Serial), no intermediate String
+template <typename Buffer>
+size_t EstiaFrame::printHex(Print& print, const Buffer& buffer) {
+	size_t written = 0;
+	char hex[3] = {' ', 0x00, 0x00};
+	bool first = true;
+	for (auto& byte : buffer) {
+		hexByte(byte, hex + 1);
+		written += print.write(reinterpret_cast<const uint8_t*>(first ? hex + 1 : hex), first ? 2 : 3);
+		first = false;
+	}
+	return written;
+}
+
+template size_t EstiaFrame::printHex<FrameBuffer>(Print& print, const FrameBuffer& buffer);
+template size_t EstiaFrame::printHex<ReadBuffer>(Print& print, const ReadBuffer& buffer);
+template size_t EstiaFrame::printHex<FrameView>(Print& print, const FrameView& buffer);
+template size_t EstiaFrame::printHex<FrameHandle>(Print& print, const FrameHandle& buffer);
 
 void EstiaFrame::setSrc(uint16_t src, bool updateCrc) {
 	this->src = src;
@@ -139,7 +216,7 @@ uint16_t EstiaFrame::readUint16(uint8_t offset) {
 }
 
 uint8_t EstiaFrame::checkFrame(uint8_t type, uint16_t dataType) {
-	if (crc != crc16(buffer.data(), length - 2)) { return err_crc; }
+	if (crc != Crc16::calculate(buffer.data(), length - 2)) { return err_crc; }
 	if (this->type != type) { return err_frame_type; }
 	if (dataLength != length - FRAME_HEAD_AND_CRC_LEN) { return err_data_len; }
 	if (this->dataType != dataType) { return err_data_type; }
@@ -166,6 +243,11 @@ uint16_t EstiaFrame::readUint16(const Buffer& buffer, uint8_t offset) {
 	return (buffer.at(offset) << 8) | buffer.at(offset + 1);
 }
 
+template uint16_t EstiaFrame::readUint16<FrameBuffer>(const FrameBuffer& buffer, uint8_t offset);
+template uint16_t EstiaFrame::readUint16<ReadBuffer>(const ReadBuffer& buffer, uint8_t offset);
+template uint16_t EstiaFrame::readUint16<FrameView>(const FrameView& buffer, uint8_t offset);
+
+// bitwise reference implementation, library uses table driven Crc16
 // https://gist.github.com/aurelj/270bb8af82f65fa645c1?permalink_comment_id=2884584#gistcomment-2884584
 uint16_t EstiaFrame::crc16(uint8_t* data, size_t len) {
 	uint16_t crc = 0xffff;
@@ -201,6 +283,7 @@ bool EstiaFrame::isStatusFrame(const Buffer& buffer) {
 
 template bool EstiaFrame::isStatusFrame<ReadBuffer>(const ReadBuffer& buffer);
 template bool EstiaFrame::isStatusFrame<FrameBuffer>(const FrameBuffer& buffer);
+template bool EstiaFrame::isStatusFrame<FrameView>(const FrameView& buffer);
 
 template <typename Buffer>
 bool EstiaFrame::isStatusUpdateFrame(const Buffer& buffer) {
@@ -212,6 +295,7 @@ bool EstiaFrame::isStatusUpdateFrame(const Buffer& buffer) {
 
 template bool EstiaFrame::isStatusUpdateFrame<ReadBuffer>(const ReadBuffer& buffer);
 template bool EstiaFrame::isStatusUpdateFrame<FrameBuffer>(const FrameBuffer& buffer);
+template bool EstiaFrame::isStatusUpdateFrame<FrameView>(const FrameView& buffer);
 
 template <typename Buffer>
 bool EstiaFrame::isAckFrame(const Buffer& buffer) {
@@ -223,6 +307,7 @@ bool EstiaFrame::isAckFrame(const Buffer& buffer) {
 
 template bool EstiaFrame::isAckFrame<ReadBuffer>(const ReadBuffer& buffer);
 template bool EstiaFrame::isAckFrame<FrameBuffer>(const FrameBuffer& buffer);
+template bool EstiaFrame::isAckFrame<FrameView>(const FrameView& buffer);
 
 template <typename Buffer>
 bool EstiaFrame::isDataResFrame(const Buffer& buffer) {
@@ -234,3 +319,52 @@ bool EstiaFrame::isDataResFrame(const Buffer& buffer) {
 
 template bool EstiaFrame::isDataResFrame<ReadBuffer>(const ReadBuffer& buffer);
 template bool EstiaFrame::isDataResFrame<FrameBuffer>(const FrameBuffer& buffer);
+template bool EstiaFrame::isDataResFrame<FrameView>(const FrameView& buffer);
+
+// frame decoded in place, view must outlive decoding
+ReceivedFrame::ReceivedFrame(const FrameView& view, uint8_t length)
+    : view(view)
+    , length(length)
+    , type(0x00)
+    , dataLength(0x00)
+    , src(0x0000)
+    , dst(0x0000)
+    , dataType(0x0000)
+    , crc(0x0000) {
+	if (view.size() < FRAME_MIN_LEN) { return; }
+
+	type = view[FRAME_TYPE_OFFSET];
+	dataLength = view[FRAME_DATA_LEN_OFFSET];
+	src = readUint16(FRAME_SRC_OFFSET);
+	dst = readUint16(FRAME_DST_OFFSET);
+	dataType = readUint16(FRAME_DATA_TYPE_OFFSET);
+	crc = readUint16(view.size() - 2);
+}
+
+const uint8_t* ReceivedFrame::data() const {
+	return view.data();
+}
+
+uint8_t ReceivedFrame::size() const {
+	return view.size();
+}
+
+const FrameView& ReceivedFrame::frame() const {
+	return view;
+}
+
+uint16_t ReceivedFrame::readUint16(uint8_t offset) const {
+	return EstiaFrame::readUint16(view, offset);
+}
+
+uint8_t ReceivedFrame::checkFrame(uint8_t type, uint16_t dataType) {
+	if (view.size() < FRAME_MIN_LEN) { return err_data_len; }
+	if (view.crc() == FrameView::crc_unchecked) {
+		view.setCrc(crc == Crc16::calculate(view.data(), view.size() - 2) ? FrameView::crc_valid : FrameView::crc_invalid);
+	}
+	if (!view.crcVerified()) { return err_crc; }
+	if (this->type != type) { return err_frame_type; }
+	if (view.size() != length || dataLength != length - FRAME_HEAD_AND_CRC_LEN) { return err_data_len; }
+	if (this->dataType != dataType) { return err_data_type; }
+	return err_ok;
+}
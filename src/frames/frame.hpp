@@ -18,12 +18,13 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
-#include <Print.h>
-#include <WString.h>
-#include <deque>
+#include "../host/arduino-compat.hpp"
+#include "crc16.hpp"
+#include "fixed-buffer.hpp"
+#include "frame-view.hpp"
+#include "ring-buffer.hpp"
 #include <stdint.h>
 #include <utility>
-#include <vector>
 
 #define FRAME_TYPE_OFFSET 2
 #define FRAME_DATA_LEN_OFFSET 3
@@ -94,11 +95,70 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 #define FRAME_FORCE_DEFROST_LEN 16
 #define FRAME_STATUS2_LEN 15
 #define FRAME_SHORT_STATUS_LEN 17
+#define READ_BUFFER_SIZE 256    // power of 2
+#define COMMAND_FRAME_MAX_LEN FRAME_TEMPERATURE_LEN
+
+using ReadBuffer = RingBuffer<uint8_t, READ_BUFFER_SIZE>;    // lock-free SPSC
+using ReadTimes = RingBuffer<uint32_t, READ_BUFFER_SIZE>;    // ReadBuffer bytes receive time (us)
+using FrameBuffer = FixedBuffer<FRAME_MAX_LEN>;    // no heap allocation
+
+/** Pre-encoded command frame, constexpr so it can be built at compile time and stored in flash.
+*
+* ```
+* constexpr CommandFrame frame = CommandFrame(type, length, src, dst, dataType).setByte(offset, value).updateCrc();
+* ```
+*/
+struct CommandFrame {
+	uint8_t length;
+	uint8_t bytes[COMMAND_FRAME_MAX_LEN];
+
+	constexpr CommandFrame()
+	    : length(0)
+	    , bytes() {
+	}
+	constexpr CommandFrame(uint8_t type, uint8_t length, uint16_t src, uint16_t dst, uint16_t dataType)
+	    : length(length <= COMMAND_FRAME_MAX_LEN ? length : COMMAND_FRAME_MAX_LEN)
+	    , bytes() {
+		bytes[0] = FRAME_BEGIN >> 8;
+		bytes[FRAME_TYPE_OFFSET] = type;
+		bytes[FRAME_DATA_LEN_OFFSET] = this->length - FRAME_HEAD_AND_CRC_LEN;
+		setUint16(FRAME_SRC_OFFSET, src);
+		setUint16(FRAME_DST_OFFSET, dst);
+		setUint16(FRAME_DATA_TYPE_OFFSET, dataType);
+	}
+	constexpr CommandFrame& setByte(uint8_t offset, uint8_t value) {
+		if (offset < length) { bytes[offset] = value; }
+		return *this;
+	}
+	constexpr CommandFrame& setUint16(uint8_t offset, uint16_t value) {
+		setByte(offset, value >> 8);
+		return setByte(offset + 1, value & 0xff);
+	}
+	constexpr CommandFrame& updateCrc() {
+		return setUint16(length - FRAME_CRC_LEN, Crc16::compute(bytes, length - FRAME_CRC_LEN));
+	}
+	constexpr bool equals(const uint8_t* frame, size_t len) const {
+		if (len != length) { return false; }
+		for (size_t idx = 0; idx < len; idx++) {
+			if (bytes[idx] != frame[idx]) { return false; }
+		}
+		return true;
+	}
+};
 
-using ReadBuffer = std::deque<uint8_t>;
-using FrameBuffer = std::vector<uint8_t>;
+class FrameError {
+  public:
+	enum Error {
+		err_ok,
+		err_crc,
+		err_frame_type,
+		err_data_len,
+		err_data_type,
+		err_other,
+	};
+};
 
-class EstiaFrame {
+class EstiaFrame : public FrameError {
   private:
   protected:
 	FrameBuffer buffer;
@@ -121,18 +181,10 @@ class EstiaFrame {
 	void updateCrc();
 
   public:
-	enum Error {
-		err_ok,
-		err_crc,
-		err_frame_type,
-		err_data_len,
-		err_data_type,
-		err_other,
-	};
-
 	EstiaFrame(FrameBuffer&& buffer, uint8_t length);
 	EstiaFrame(FrameBuffer& buffer, uint8_t length);
 	EstiaFrame(uint8_t type, uint8_t length);
+	EstiaFrame(const CommandFrame& frame);
 
 	const uint8_t* data() const;
 	uint8_t size() const;
@@ -140,10 +192,15 @@ class EstiaFrame {
 	static bool writeUint16(Buffer& buffer, uint8_t offset, uint16_t data);
 	template <typename Buffer>
 	static uint16_t readUint16(const Buffer& buffer, uint8_t offset);
-	static uint16_t crc16(uint8_t* data, size_t len);    // CRC-16/MCRF4XX
+	static uint16_t crc16(uint8_t* data, size_t len);    // CRC-16/MCRF4XX bitwise reference, see Crc16
 	String stringify();
 	template <typename Buffer>
 	static String stringify(const Buffer& buffer);
+	static char* hexByte(uint8_t byte, char* out);
+	template <typename Buffer>
+	static size_t toHex(const Buffer& buffer, char* out, size_t outSize);
+	template <typename Buffer>
+	static size_t printHex(Print& print, const Buffer& buffer);
 	static FrameBuffer readBuffToFrameBuff(const ReadBuffer& buffer);
 	template <typename Buffer>
 	static bool isStatusFrame(const Buffer& buffer);
@@ -156,3 +213,30 @@ class EstiaFrame {
 
 	friend class EstiaSerial;
 };
+
+/** Base for received frames decoders, decodes in place from FrameView (no copy).
+*
+* CRC is checked only if view CRC state is `FrameView::crc_unchecked`.
+*/
+class ReceivedFrame : public FrameError {
+  private:
+  protected:
+	FrameView view;
+	uint8_t length;
+	uint8_t type;
+	uint8_t dataLength;
+	uint16_t src;
+	uint16_t dst;
+	uint16_t dataType;
+	uint16_t crc;
+
+	uint16_t readUint16(uint8_t offset) const;
+	uint8_t checkFrame(uint8_t type, uint16_t dataType);
+
+  public:
+	ReceivedFrame(const FrameView& view, uint8_t length);
+
+	const uint8_t* data() const;
+	uint8_t size() const;
+	const FrameView& frame() const;
+};
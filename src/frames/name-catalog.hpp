@@ -0,0 +1,114 @@
+/*
+name-catalog.hpp - Estia R32 heat pump compile time name lookup tables
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../host/arduino-compat.hpp"
+#include <string>
+
+#define CATALOG_NAME_SIZE 22    // longest name + terminator
+
+template <typename Value>
+struct CatalogEntry {
+	char name[CATALOG_NAME_SIZE];
+	Value value;
+};
+
+/** Name to value table sorted by name, stored in flash.
+*
+* Entries are written in name order (checked at compile time with `sorted()`),
+* lookup is binary search with `strcmp_P`, no static constructors and no allocation.
+* Object must be `constexpr` (`PROGMEM`), values are read with `memcpy_P`.
+*/
+template <typename Value, size_t Size>
+struct NameCatalog {
+	CatalogEntry<Value> entries[Size];
+
+	static constexpr int compare(const char* a, const char* b) {
+		while (*a != '\0' && *a == *b) {
+			a++;
+			b++;
+		}
+		return static_cast<uint8_t>(*a) - static_cast<uint8_t>(*b);
+	}
+	constexpr bool sorted() const {
+		for (size_t idx = 1; idx < Size; idx++) {
+			if (compare(entries[idx - 1].name, entries[idx].name) >= 0) { return false; }
+		}
+		return true;
+	}
+	static constexpr size_t size() {
+		return Size;
+	}
+
+	/** @return false for unknown name, `value` is not changed */
+	bool find(const char* name, Value& value) const {
+		size_t low = 0;
+		size_t high = Size;
+		while (low < high) {
+			size_t mid = (low + high) / 2;
+			int result = strcmp_P(name, entries[mid].name);
+			if (result == 0) {
+				memcpy_P(&value, &entries[mid].value, sizeof(Value));
+				return true;
+			}
+			if (result < 0) {
+				high = mid;
+			} else {
+				low = mid + 1;
+			}
+		}
+		return false;
+	}
+	size_t count(const char* name) const {
+		Value value;
+		return find(name, value) ? 1 : 0;
+	}
+	size_t count(const std::string& name) const {
+		return count(name.c_str());
+	}
+	/** @return value, `Value()` for unknown name */
+	Value at(const char* name) const {
+		Value value = Value();
+		find(name, value);
+		return value;
+	}
+	Value at(const std::string& name) const {
+		return at(name.c_str());
+	}
+
+	/** Copy name of first entry with `value` to `out` (value to name lookup).
+	*
+	* @return false when value is not in table, `out` is empty string
+	*/
+	bool nameOf(Value value, char* out, size_t outSize) const {
+		if (outSize == 0) { return false; }
+
+		out[0] = '\0';
+		for (const CatalogEntry<Value>& entry : entries) {
+			Value entryValue;
+			memcpy_P(&entryValue, &entry.value, sizeof(Value));
+			if (entryValue == value) {
+				strncpy_P(out, entry.name, outSize - 1);
+				out[outSize - 1] = '\0';
+				return true;
+			}
+		}
+		return false;
+	}
+};
@@ -0,0 +1,123 @@
+/*
+ring-buffer.hpp - Estia R32 heat pump lock-free receive ring buffer
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Fixed size single producer / single consumer ring buffer.
+*
+* Producer (UART ISR, RX task or main loop) calls `push_back()` only,
+* consumer (main loop) calls everything else. Indices are free running
+* atomics, no locks and no heap. When full new bytes are dropped and
+* counted in `overflows()`.
+* @tparam Size capacity, power of 2
+*/
+template <typename T, size_t Size>
+class RingBuffer {
+	static_assert(Size != 0 && (Size & (Size - 1)) == 0, "RingBuffer size must be power of 2");
+
+  private:
+	T buffer[Size];
+	std::atomic<size_t> head;    // written by producer
+	std::atomic<size_t> tail;    // written by consumer
+	std::atomic<uint32_t> overflow;
+
+	static size_t mask(size_t idx) { return idx & (Size - 1); }
+
+  public:
+	class const_iterator {
+	  private:
+		const RingBuffer* ring;
+		size_t idx;
+
+	  public:
+		const_iterator(const RingBuffer* ring, size_t idx)
+		    : ring(ring)
+		    , idx(idx) {
+		}
+		const T& operator*() const { return ring->buffer[mask(idx)]; }
+		const_iterator& operator++() {
+			idx++;
+			return *this;
+		}
+		bool operator==(const const_iterator& other) const { return idx == other.idx; }
+		bool operator!=(const const_iterator& other) const { return idx != other.idx; }
+	};
+
+	using value_type = T;
+	using size_type = size_t;
+
+	RingBuffer()
+	    : head(0)
+	    , tail(0)
+	    , overflow(0) {
+	}
+
+	// producer
+	bool push_back(const T& value) {
+		size_t headIdx = head.load(std::memory_order_relaxed);
+		if (headIdx - tail.load(std::memory_order_acquire) >= Size) {
+			overflow.store(overflow.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return false;
+		}
+		buffer[mask(headIdx)] = value;
+		head.store(headIdx + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer
+	size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed); }
+	bool empty() const { return size() == 0; }
+	bool full() const { return size() >= Size; }
+	static constexpr size_t capacity() { return Size; }
+	uint32_t overflows() const { return overflow.load(std::memory_order_relaxed); }
+
+	T& at(size_t idx) { return buffer[mask(tail.load(std::memory_order_relaxed) + idx)]; }
+	const T& at(size_t idx) const { return buffer[mask(tail.load(std::memory_order_relaxed) + idx)]; }
+	T& operator[](size_t idx) { return at(idx); }
+	const T& operator[](size_t idx) const { return at(idx); }
+	const T& front() const { return at(0); }
+
+	const_iterator begin() const { return const_iterator(this, tail.load(std::memory_order_relaxed)); }
+	const_iterator end() const { return const_iterator(this, head.load(std::memory_order_acquire)); }
+
+	void pop_front() { consume(1); }
+	void clear() { tail.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+	void consume(size_t count) {
+		size_t available = size();
+		if (count > available) { count = available; }
+		tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+	}
+
+	/** Contiguous span of oldest elements, without copying.
+	*
+	* Data wrapped around buffer end is returned by next `peek()` after `consume()`.
+	* @param data set to oldest element
+	* @return number of contiguous elements available at `data`
+	*/
+	size_t peek(const T*& data) const {
+		size_t tailIdx = tail.load(std::memory_order_relaxed);
+		size_t available = head.load(std::memory_order_acquire) - tailIdx;
+		size_t contiguous = Size - mask(tailIdx);
+		data = &buffer[mask(tailIdx)];
+		return available < contiguous ? available : contiguous;
+	}
+};
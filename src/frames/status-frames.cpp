@@ -18,52 +18,413 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 
 #include "status-frames.hpp"
 
-StatusFrame::StatusFrame(FrameBuffer&& buffer, uint8_t length)
-    : EstiaFrame::EstiaFrame(buffer, length)
+// `StatusData` member names, indexed by `StatusChanges::Field`
+static constexpr const char* statusFieldNames[] = {
+    "error",
+    "operationMode",
+    "extendedData",
+    "cooling",
+    "heating",
+    "hotWater",
+    "autoMode",
+    "quietMode",
+    "nightMode",
+    "backupHeater",
+    "coolingCMP",
+    "heatingCMP",
+    "hotWaterHeater",
+    "hotWaterCMP",
+    "pump1",
+    "hotWaterTarget",
+    "zone1Target",
+    "zone2Target",
+    "hotWaterTarget2",
+    "zone1Target2",
+    "zone2Target2",
+    "defrostInProgress",
+    "nightModeActive",
+    "waterOutletTemperature",
+    "waterInletTemperature",
+};
+
+static_assert(sizeof(statusFieldNames) / sizeof(statusFieldNames[0]) == StatusChanges::field_count, "status field names do not match fields");
+
+StatusChanges::const_iterator::const_iterator(uint32_t mask, uint8_t field)
+    : mask(mask)
+    , field(field) {
+	while (this->field < field_count && (mask & (1UL << this->field)) == 0) {
+		this->field++;
+	}
+}
+
+StatusChanges::Field StatusChanges::const_iterator::operator*() const {
+	return static_cast<Field>(field);
+}
+
+StatusChanges::const_iterator& StatusChanges::const_iterator::operator++() {
+	*this = const_iterator(mask, field + 1);
+	return *this;
+}
+
+bool StatusChanges::const_iterator::operator!=(const const_iterator& other) const {
+	return field != other.field;
+}
+
+StatusChanges::StatusChanges(uint32_t mask)
+    : mask(mask) {
+}
+
+// every field, first status
+StatusChanges StatusChanges::all() {
+	return StatusChanges((1UL << field_count) - 1);
+}
+
+StatusChanges StatusChanges::compare(const StatusData& previous, const StatusData& current) {
+	StatusChanges changes;
+	changes.set(field_error, previous.error != current.error);
+	changes.set(field_operation_mode, previous.operationMode != current.operationMode);
+	changes.set(field_extended_data, previous.extendedData != current.extendedData);
+	changes.set(field_cooling, previous.cooling != current.cooling);
+	changes.set(field_heating, previous.heating != current.heating);
+	changes.set(field_hot_water, previous.hotWater != current.hotWater);
+	changes.set(field_auto_mode, previous.autoMode != current.autoMode);
+	changes.set(field_quiet_mode, previous.quietMode != current.quietMode);
+	changes.set(field_night_mode, previous.nightMode != current.nightMode);
+	changes.set(field_backup_heater, previous.backupHeater != current.backupHeater);
+	changes.set(field_cooling_cmp, previous.coolingCMP != current.coolingCMP);
+	changes.set(field_heating_cmp, previous.heatingCMP != current.heatingCMP);
+	changes.set(field_hot_water_heater, previous.hotWaterHeater != current.hotWaterHeater);
+	changes.set(field_hot_water_cmp, previous.hotWaterCMP != current.hotWaterCMP);
+	changes.set(field_pump1, previous.pump1 != current.pump1);
+	changes.set(field_hot_water_target, previous.hotWaterTarget != current.hotWaterTarget);
+	changes.set(field_zone1_target, previous.zone1Target != current.zone1Target);
+	changes.set(field_zone2_target, previous.zone2Target != current.zone2Target);
+	changes.set(field_hot_water_target2, previous.hotWaterTarget2 != current.hotWaterTarget2);
+	changes.set(field_zone1_target2, previous.zone1Target2 != current.zone1Target2);
+	changes.set(field_zone2_target2, previous.zone2Target2 != current.zone2Target2);
+	changes.set(field_defrost_in_progress, previous.defrostInProgress != current.defrostInProgress);
+	changes.set(field_night_mode_active, previous.nightModeActive != current.nightModeActive);
+	changes.set(field_water_outlet_temperature, previous.waterOutletTemperature != current.waterOutletTemperature);
+	changes.set(field_water_inlet_temperature, previous.waterInletTemperature != current.waterInletTemperature);
+	return changes;
+}
+
+// `StatusData` member name
+const char* StatusChanges::name(Field field) {
+	return field < field_count ? statusFieldNames[field] : "";
+}
+
+/** @return field value, bool as `0` `1` */
+int16_t StatusChanges::value(const StatusData& data, Field field) {
+	switch (field) {
+	case field_error:
+		return data.error;
+	case field_operation_mode:
+		return data.operationMode;
+	case field_extended_data:
+		return data.extendedData;
+	case field_cooling:
+		return data.cooling;
+	case field_heating:
+		return data.heating;
+	case field_hot_water:
+		return data.hotWater;
+	case field_auto_mode:
+		return data.autoMode;
+	case field_quiet_mode:
+		return data.quietMode;
+	case field_night_mode:
+		return data.nightMode;
+	case field_backup_heater:
+		return data.backupHeater;
+	case field_cooling_cmp:
+		return data.coolingCMP;
+	case field_heating_cmp:
+		return data.heatingCMP;
+	case field_hot_water_heater:
+		return data.hotWaterHeater;
+	case field_hot_water_cmp:
+		return data.hotWaterCMP;
+	case field_pump1:
+		return data.pump1;
+	case field_hot_water_target:
+		return data.hotWaterTarget;
+	case field_zone1_target:
+		return data.zone1Target;
+	case field_zone2_target:
+		return data.zone2Target;
+	case field_hot_water_target2:
+		return data.hotWaterTarget2;
+	case field_zone1_target2:
+		return data.zone1Target2;
+	case field_zone2_target2:
+		return data.zone2Target2;
+	case field_defrost_in_progress:
+		return data.defrostInProgress;
+	case field_night_mode_active:
+		return data.nightModeActive;
+	case field_water_outlet_temperature:
+		return data.waterOutletTemperature;
+	case field_water_inlet_temperature:
+		return data.waterInletTemperature;
+	default:
+		return 0;
+	}
+}
+
+void StatusChanges::set(Field field, bool changed) {
+	if (changed) { mask |= 1UL << field; }
+}
+
+bool StatusChanges::has(Field field) const {
+	return (mask & (1UL << field)) != 0;
+}
+
+// any of fields mask bits changed
+bool StatusChanges::any(uint32_t fields) const {
+	return (mask & fields) != 0;
+}
+
+bool StatusChanges::empty() const {
+	return mask == 0;
+}
+
+uint8_t StatusChanges::count() const {
+	uint8_t count = 0;
+	for (uint32_t bits = mask; bits != 0; bits &= bits - 1) {
+		count++;
+	}
+	return count;
+}
+
+StatusChanges& StatusChanges::operator|=(const StatusChanges& other) {
+	mask |= other.mask;
+	return *this;
+}
+
+StatusChanges::const_iterator StatusChanges::begin() const {
+	return const_iterator(mask, 0);
+}
+
+StatusChanges::const_iterator StatusChanges::end() const {
+	return const_iterator(0, field_count);
+}
+
+PackedStatus::PackedStatus()
+    : payload()
+    , temperatures()
+    , extended(false) {
+}
+
+/** @param frame checked long status or update frame */
+PackedStatus::PackedStatus(const FrameView& frame)
+    : PackedStatus() {
+	extended = frame.size() == FRAME_STATUS_LEN;
+	if (extended) {
+		memcpy(payload, frame.data() + STATUS_PAYLOAD_OFFSET, STATUS_PAYLOAD_LEN);
+		temperatures[0] = frame[STATUS_TWO_OFFSET];
+		temperatures[1] = frame[STATUS_TWI_OFFSET];
+	} else {
+		memcpy(payload, frame.data() + STATUS_PAYLOAD_OFFSET, STATUS_UPDATE_PAYLOAD_LEN);
+		payload[STATUS_PAYLOAD_LEN - 1] = frame[STATUS_UPDATE_FLAGS_OFFSET];
+	}
+}
+
+// apply newer frame, update frame keeps long frame fields
+void PackedStatus::merge(const PackedStatus& frame) {
+	if (frame.extended) {
+		*this = frame;
+		return;
+	}
+	memcpy(payload, frame.payload, STATUS_UPDATE_PAYLOAD_LEN);
+	payload[STATUS_PAYLOAD_LEN - 1] = frame.payload[STATUS_PAYLOAD_LEN - 1];
+}
+
+bool PackedStatus::operator==(const PackedStatus& other) const {
+	return extended == other.extended &&
+	       memcmp(payload, other.payload, STATUS_PAYLOAD_LEN) == 0 &&
+	       memcmp(temperatures, other.temperatures, sizeof(temperatures)) == 0;
+}
+
+bool PackedStatus::operator!=(const PackedStatus& other) const {
+	return !(*this == other);
+}
+
+// FNV-1a of raw bytes
+uint32_t PackedStatus::hash() const {
+	uint32_t hash = 2166136261UL;
+	for (uint8_t byte : payload) {
+		hash = (hash ^ byte) * 16777619UL;
+	}
+	for (uint8_t byte : temperatures) {
+		hash = (hash ^ byte) * 16777619UL;
+	}
+	return (hash ^ extended) * 16777619UL;
+}
+
+// all fields, compatible struct
+StatusData PackedStatus::unpack() const {
+	StatusData data = {};
+	data.error = ReceivedFrame::err_ok;
+	data.operationMode = operationMode();
+	data.extendedData = extendedData();
+	data.cooling = cooling();
+	data.heating = heating();
+	data.hotWater = hotWater();
+	data.autoMode = autoMode();
+	data.quietMode = quietMode();
+	data.nightMode = nightMode();
+	data.backupHeater = backupHeater();
+	data.coolingCMP = coolingCMP();
+	data.heatingCMP = heatingCMP();
+	data.hotWaterHeater = hotWaterHeater();
+	data.hotWaterCMP = hotWaterCMP();
+	data.pump1 = pump1();
+	data.hotWaterTarget = hotWaterTarget();
+	data.zone1Target = zone1Target();
+	data.zone2Target = zone2Target();
+	data.defrostInProgress = defrostInProgress();
+	data.nightModeActive = nightModeActive();
+	if (extended) {
+		data.hotWaterTarget2 = hotWaterTarget2();
+		data.zone1Target2 = zone1Target2();
+		data.zone2Target2 = zone2Target2();
+		data.waterOutletTemperature = waterOutletTemperature();
+		data.waterInletTemperature = waterInletTemperature();
+	}
+	return data;
+}
+
+// long frame byte
+uint8_t PackedStatus::at(uint8_t offset) const {
+	return payload[offset - STATUS_PAYLOAD_OFFSET];
+}
+
+// long frame fields are valid
+bool PackedStatus::extendedData() const {
+	return extended;
+}
+
+uint8_t PackedStatus::operationMode() const {
+	return (at(11) & 0xe0) >> 5;
+}
+
+bool PackedStatus::cooling() const {
+	return (at(11) & 0xa1) == 0xa1;
+}
+
+bool PackedStatus::heating() const {
+	return (at(11) & 0xc1) == 0xc1;
+}
+
+bool PackedStatus::hotWater() const {
+	return (at(11) & 0x02) >> 1 == 0x01;
+}
+
+bool PackedStatus::autoMode() const {
+	return (at(12) & 0x04) >> 2 == 0x01;
+}
+
+bool PackedStatus::quietMode() const {
+	return (at(12) & 0x10) >> 4 == 0x01;
+}
+
+bool PackedStatus::nightMode() const {
+	return (at(12) & 0x20) >> 5 == 0x01;
+}
+
+bool PackedStatus::backupHeater() const {
+	return (at(13) & 0x01) >> 0 == 0x01;
+}
+
+bool PackedStatus::coolingCMP() const {
+	return (at(13) & 0x02) >> 1 == 0x01 && operationMode() == 0x05;
+}
+
+bool PackedStatus::heatingCMP() const {
+	return (at(13) & 0x02) >> 1 == 0x01 && operationMode() == 0x06;
+}
+
+bool PackedStatus::hotWaterHeater() const {
+	return (at(13) & 0x04) >> 2 == 0x01;
+}
+
+bool PackedStatus::hotWaterCMP() const {
+	return (at(13) & 0x08) >> 3 == 0x01;
+}
+
+bool PackedStatus::pump1() const {
+	return (at(13) & 0x10) >> 4 == 0x01;
+}
+
+uint8_t PackedStatus::hotWaterTarget() const {
+	return at(14) / 0x02 - 0x10;
+}
+
+uint8_t PackedStatus::zone1Target() const {
+	return at(15) / 0x02 - 0x10;
+}
+
+uint8_t PackedStatus::zone2Target() const {
+	return at(16) / 0x02 - 0x10;
+}
+
+uint8_t PackedStatus::hotWaterTarget2() const {
+	return at(17) / 0x02 - 0x10;
+}
+
+uint8_t PackedStatus::zone1Target2() const {
+	return at(18) / 0x02 - 0x10;
+}
+
+uint8_t PackedStatus::zone2Target2() const {
+	return at(19) / 0x02 - 0x10;
+}
+
+bool PackedStatus::defrostInProgress() const {
+	return (at(21) & 0x02) == 0x02;
+}
+
+bool PackedStatus::nightModeActive() const {
+	return (at(21) & 0x10) == 0x10;
+}
+
+int8_t PackedStatus::waterOutletTemperature() const {
+	return temperatures[0] / 0x02 - 0x10;
+}
+
+int8_t PackedStatus::waterInletTemperature() const {
+	return temperatures[1] / 0x02 - 0x10;
+}
+
+StatusFrame::StatusFrame(const FrameView& buffer, uint8_t length)
+    : ReceivedFrame::ReceivedFrame(buffer, length)
     , longFrame(length == FRAME_STATUS_LEN)
+    , packed()
     , error(0) {
 	error = checkFrame(longFrame ? FRAME_TYPE_STATUS : FRAME_TYPE_UPDATE, FRAME_DATA_TYPE_STATUS);
+	decodeInPlace();
 }
 
 StatusFrame::StatusFrame(FrameBuffer& buffer, uint8_t length)
-    : StatusFrame::StatusFrame(std::forward<FrameBuffer>(buffer), length) {
+    : StatusFrame::StatusFrame(FrameView(buffer), length) {
 }
 
-StatusFrame::StatusFrame(ReadBuffer& buffer, uint8_t length)
-    : StatusFrame::StatusFrame(readBuffToFrameBuff(buffer), length) {
+// raw bytes copied while view is valid, fields are decoded on demand
+void StatusFrame::decodeInPlace() {
+	if (error == err_ok) { packed = PackedStatus(view); }
 }
 
 StatusData StatusFrame::decode() {
-	StatusData data;
-	data.error = error;
-	if (error == err_ok) {
-		data.extendedData = longFrame;
-		data.operationMode = (buffer.at(11) & 0xe0) >> 5;
-		data.cooling = (buffer.at(11) & 0xa1) == 0xa1;
-		data.heating = (buffer.at(11) & 0xc1) == 0xc1;
-		data.hotWater = (buffer.at(11) & 0x02) >> 1 == 0x01;
-		data.autoMode = (buffer.at(12) & 0x04) >> 2 == 0x01;
-		data.quietMode = (buffer.at(12) & 0x10) >> 4 == 0x01;
-		data.nightMode = (buffer.at(12) & 0x20) >> 5 == 0x01;
-		data.backupHeater = (buffer.at(13) & 0x01) >> 0 == 0x01;
-		data.coolingCMP = (buffer.at(13) & 0x02) >> 1 == 0x01 && data.operationMode == 0x05;
-		data.heatingCMP = (buffer.at(13) & 0x02) >> 1 == 0x01 && data.operationMode == 0x06;
-		data.hotWaterHeater = (buffer.at(13) & 0x04) >> 2 == 0x01;
-		data.hotWaterCMP = (buffer.at(13) & 0x08) >> 3 == 0x01;
-		data.pump1 = (buffer.at(13) & 0x10) >> 4 == 0x01;
-		data.hotWaterTarget = buffer.at(14) / 0x02 - 0x10;
-		data.zone1Target = buffer.at(15) / 0x02 - 0x10;
-		data.zone2Target = buffer.at(16) / 0x02 - 0x10;
-		if (longFrame) {
-			data.hotWaterTarget2 = buffer.at(17) / 0x02 - 0x10;
-			data.zone1Target2 = buffer.at(18) / 0x02 - 0x10;
-			data.zone2Target2 = buffer.at(19) / 0x02 - 0x10;
-			data.defrostInProgress = (buffer.at(21) & 0x02) == 0x02;
-			data.nightModeActive = (buffer.at(21) & 0x10) == 0x10;
-		} else {
-			data.defrostInProgress = (buffer.at(17) & 0x02) == 0x02;
-			data.nightModeActive = (buffer.at(17) & 0x10) == 0x10;
-		}
+	if (error != err_ok) {
+		StatusData data = {};
+		data.error = error;
+		return data;
 	}
-	return data;
+	return packed.unpack();
+}
+
+// this frame only, `PackedStatus::merge()` applies update frame to previous status
+const PackedStatus& StatusFrame::pack() const {
+	return packed;
 }
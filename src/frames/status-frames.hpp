@@ -23,7 +23,7 @@ License along with this library; if not, see <https://www.gnu.org/licenses/>.
 struct StatusData {
 	uint8_t error;
 	uint8_t operationMode;
-	bool extendedData;
+	bool extendedData;    // long frame received, fields below marked long frame are valid
 	bool cooling;
 	bool heating;
 	bool hotWater;
@@ -39,26 +39,154 @@ struct StatusData {
 	uint8_t hotWaterTarget;
 	uint8_t zone1Target;
 	uint8_t zone2Target;
-	uint8_t hotWaterTarget2;
-	uint8_t zone1Target2;
-	uint8_t zone2Target2;
+	uint8_t hotWaterTarget2;    // long frame only
+	uint8_t zone1Target2;       // long frame only
+	uint8_t zone2Target2;       // long frame only
 	bool defrostInProgress;
 	bool nightModeActive;
+	int8_t waterOutletTemperature;    // TWO, long frame only
+	int8_t waterInletTemperature;     // TWI, long frame only
 };
 
+/** Changed `StatusData` fields, bit per field. */
+class StatusChanges {
+  public:
+	enum Field : uint8_t {
+		field_error,
+		field_operation_mode,
+		field_extended_data,
+		field_cooling,
+		field_heating,
+		field_hot_water,
+		field_auto_mode,
+		field_quiet_mode,
+		field_night_mode,
+		field_backup_heater,
+		field_cooling_cmp,
+		field_heating_cmp,
+		field_hot_water_heater,
+		field_hot_water_cmp,
+		field_pump1,
+		field_hot_water_target,
+		field_zone1_target,
+		field_zone2_target,
+		field_hot_water_target2,
+		field_zone1_target2,
+		field_zone2_target2,
+		field_defrost_in_progress,
+		field_night_mode_active,
+		field_water_outlet_temperature,
+		field_water_inlet_temperature,
+		field_count,
+	};
+
+	// changed fields in `Field` order
+	class const_iterator {
+	  private:
+		uint32_t mask;
+		uint8_t field;
+
+	  public:
+		const_iterator(uint32_t mask, uint8_t field);
+		Field operator*() const;
+		const_iterator& operator++();
+		bool operator!=(const const_iterator& other) const;
+	};
+
+	uint32_t mask;
+
+	StatusChanges(uint32_t mask = 0);
+
+	static StatusChanges all();
+	static StatusChanges compare(const StatusData& previous, const StatusData& current);
+	static const char* name(Field field);
+	static int16_t value(const StatusData& data, Field field);
+	void set(Field field, bool changed = true);
+	bool has(Field field) const;
+	bool any(uint32_t fields) const;
+	bool empty() const;
+	uint8_t count() const;
+	StatusChanges& operator|=(const StatusChanges& other);
+	const_iterator begin() const;
+	const_iterator end() const;
+};
+
+static_assert(StatusChanges::field_count <= 32, "status fields do not fit changes mask");
+
 #define STATUS_SRC FRAME_SRC_DST_MASTER
 #define STATUS_DST FRAME_SRC_DST_BROADCAST
+#define STATUS_TWO_OFFSET 26    // long frame, value / 2 - 16
+#define STATUS_TWI_OFFSET 27    // long frame, value / 2 - 16
+#define STATUS_PAYLOAD_OFFSET 11         // status bytes 11-21 (long frame)
+#define STATUS_PAYLOAD_LEN 11
+#define STATUS_UPDATE_PAYLOAD_LEN 6      // update frame bytes 11-16, byte 17 is long frame byte 21
+#define STATUS_UPDATE_FLAGS_OFFSET 17
 
-class StatusFrame : public EstiaFrame {
+/** Status kept as raw frame bytes, fields are decoded only when read.
+*
+* Long frame bytes 11-21 and TWO/TWI bytes 26-27 (14 Bytes with extended flag),
+* update frame replaces only bytes it carries (`merge()`). Equality and hash
+* compare raw bytes.
+*/
+class PackedStatus {
+  private:
+	uint8_t payload[STATUS_PAYLOAD_LEN];
+	uint8_t temperatures[2];    // TWO, TWI
+	bool extended;
+
+	uint8_t at(uint8_t offset) const;
+
+  public:
+	PackedStatus();
+	PackedStatus(const FrameView& frame);
+
+	void merge(const PackedStatus& frame);
+	bool operator==(const PackedStatus& other) const;
+	bool operator!=(const PackedStatus& other) const;
+	uint32_t hash() const;
+	StatusData unpack() const;
+
+	bool extendedData() const;
+	uint8_t operationMode() const;
+	bool cooling() const;
+	bool heating() const;
+	bool hotWater() const;
+	bool autoMode() const;
+	bool quietMode() const;
+	bool nightMode() const;
+	bool backupHeater() const;
+	bool coolingCMP() const;
+	bool heatingCMP() const;
+	bool hotWaterHeater() const;
+	bool hotWaterCMP() const;
+	bool pump1() const;
+	uint8_t hotWaterTarget() const;
+	uint8_t zone1Target() const;
+	uint8_t zone2Target() const;
+	uint8_t hotWaterTarget2() const;
+	uint8_t zone1Target2() const;
+	uint8_t zone2Target2() const;
+	bool defrostInProgress() const;
+	bool nightModeActive() const;
+	int8_t waterOutletTemperature() const;
+	int8_t waterInletTemperature() const;
+};
+
+class StatusFrame : public ReceivedFrame {
   private:
 	bool longFrame;
+	PackedStatus packed;
+
+	void decodeInPlace();
 
   public:
-	StatusFrame(FrameBuffer&& buffer, uint8_t length);
+	StatusFrame(const FrameView& buffer, uint8_t length);
 	StatusFrame(FrameBuffer& buffer, uint8_t length);
-	StatusFrame(ReadBuffer& buffer, uint8_t length);
+	StatusFrame(FrameBuffer&& buffer, uint8_t length) = delete;    // frame is not copied, view would dangle
+	StatusFrame(ReadBuffer& buffer, uint8_t length) = delete;
 
 	uint8_t error;
 
 	StatusData decode();
+	const PackedStatus& pack() const;
 };
@@ -0,0 +1,66 @@
+/*
+arduino-compat.cpp - Arduino core subset for host (Linux) builds
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "arduino-compat.hpp"
+
+#if !defined(ARDUINO)
+
+#include <time.h>
+
+static uint64_t monotonicMicros() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
+
+static const uint64_t startTime = monotonicMicros();
+
+unsigned long millis() {
+	return (monotonicMicros() - startTime) / 1000;
+}
+
+unsigned long micros() {
+	return monotonicMicros() - startTime;
+}
+
+void delay(unsigned long ms) {
+	struct timespec wait = {static_cast<time_t>(ms / 1000), static_cast<long>(ms % 1000) * 1000000L};
+	while (nanosleep(&wait, &wait) != 0) {}
+}
+
+void yield() {
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+	size_t written = 0;
+	while (size--) { written += write(*buffer++); }
+	return written;
+}
+
+void String::trim() {
+	size_t first = buffer.find_first_not_of(" \t\r\n");
+	if (first == std::string::npos) {
+		buffer.clear();
+		return;
+	}
+	buffer.erase(buffer.find_last_not_of(" \t\r\n") + 1);
+	buffer.erase(0, first);
+}
+
+#endif
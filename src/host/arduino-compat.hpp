@@ -0,0 +1,94 @@
+/*
+arduino-compat.hpp - Arduino core subset for host (Linux) builds
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#if defined(ARDUINO)
+
+#include <Arduino.h>
+
+#else
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+// flash is ordinary memory on host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+#define pgm_read_float(addr) (*reinterpret_cast<const float*>(addr))
+#define memcpy_P memcpy
+#define strcmp_P strcmp
+#define strncpy_P strncpy
+#define strlen_P strlen
+
+#define HIGH 0x1
+#define LOW 0x0
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+/** Byte sink, subset of Arduino `Print`. */
+class Print {
+  public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t byte) = 0;
+	virtual size_t write(const uint8_t* buffer, size_t size);
+	size_t write(const char* str) { return write(reinterpret_cast<const uint8_t*>(str), strlen(str)); }
+	size_t print(const char* str) { return write(str); }
+	size_t println(const char* str) { return write(str) + write("\n"); }
+};
+
+/** Subset of Arduino `String` used by the library, backed by `std::string`. */
+class String {
+  private:
+	std::string buffer;
+
+  public:
+	String(const char* str = "")
+	    : buffer(str) {
+	}
+
+	bool reserve(unsigned int size) {
+		buffer.reserve(size);
+		return true;
+	}
+	bool concat(const char* str) {
+		buffer += str;
+		return true;
+	}
+	bool concat(char c) {
+		buffer += c;
+		return true;
+	}
+	void trim();
+	const char* c_str() const { return buffer.c_str(); }
+	unsigned int length() const { return buffer.size(); }
+	bool operator==(const char* str) const { return buffer == str; }
+	bool operator!=(const char* str) const { return buffer != str; }
+};
+
+#endif
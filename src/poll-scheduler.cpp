@@ -0,0 +1,292 @@
+/*
+poll-scheduler.cpp - Estia R32 heat pump periodic sensors data requests
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "poll-scheduler.hpp"
+
+PollScheduler::PollScheduler()
+    : entries()
+    , adaptive(false)
+    , maxBackoff(POLL_ADAPTIVE_MAX_BACKOFF)
+    , passiveMaxAge(POLL_PASSIVE_MAX_AGE)
+    , polls(0)
+    , totalLateness(0)
+    , requests(0)
+    , observations(0)
+    , statsStart(0) {
+}
+
+/**
+* @param code data code
+* @param period ms, `0` stops polling
+* @param priority due sensors with higher priority are requested first
+* @param now first request is due now
+* @return false for unknown code
+*/
+bool PollScheduler::setPeriod(uint8_t code, uint32_t period, Priority priority, uint32_t now) {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE) { return false; }
+
+	Entry& entry = entries[idx];
+	entry.period = period;
+	entry.lastSent = now - period;
+	entry.priority = priority;
+	entry.backoff = 0;
+	entry.pending = false;
+	return true;
+}
+
+void PollScheduler::disable(uint8_t code) {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE) { return; }
+
+	entries[idx].period = 0;
+	entries[idx].pending = false;
+}
+
+void PollScheduler::clear() {
+	for (Entry& entry : entries) {
+		entry.period = 0;
+		entry.pending = false;
+	}
+}
+
+/**
+* @param enable back off stable sensors
+* @param maxBackoff interval ceiling, `period << maxBackoff`
+*/
+void PollScheduler::setAdaptive(bool enable, uint8_t maxBackoff) {
+	adaptive = enable;
+	this->maxBackoff = maxBackoff;
+	this->wake();
+}
+
+/** @param maxAge ms, passive value younger than this skips sensor in sweep, `0` disables skipping of polled and swept sensors */
+void PollScheduler::setPassiveMaxAge(uint32_t maxAge) {
+	passiveMaxAge = maxAge;
+}
+
+/** Pick sensor to request now.
+*
+* @return data code, `SENSOR_NONE` when nothing is due
+*/
+uint8_t PollScheduler::next(uint32_t now) {
+	uint8_t best = SENSOR_NONE;
+	uint32_t bestOverdue = 0;
+	for (uint8_t idx = 0; idx < SENSORS_COUNT; idx++) {
+		const Entry& entry = entries[idx];
+		if (entry.period == 0 || entry.pending) { continue; }
+		uint32_t dueTime = due(entry);
+		if (static_cast<int32_t>(now - dueTime) < 0) { continue; }
+
+		uint32_t overdue = now - dueTime;
+		if (best == SENSOR_NONE || entry.priority > entries[best].priority ||
+		    (entry.priority == entries[best].priority && overdue > bestOverdue)) {
+			best = idx;
+			bestOverdue = overdue;
+		}
+	}
+	if (best == SENSOR_NONE) { return SENSOR_NONE; }
+
+	entries[best].pending = true;
+	return SensorStore::descriptor(best).code;
+}
+
+/** Request for picked sensor is transmitted, record lateness and schedule next one.
+*
+* Next request is due one interval after this one is sent, so sensors due at the same
+* time spread over following windows instead of competing every period.
+* Retransmissions and not polled codes are ignored.
+*/
+void PollScheduler::sent(uint8_t code, uint32_t now) {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE || !entries[idx].pending) { return; }
+
+	Entry& entry = entries[idx];
+	uint32_t lateness = now - due(entry);
+	if (static_cast<int32_t>(lateness) < 0) { lateness = 0; }    // observed while queued
+	entry.lastLateness = lateness;
+	if (lateness > entry.maxLateness) { entry.maxLateness = lateness; }
+	polls++;
+	totalLateness += lateness;
+
+	entry.lastSent = now;
+	entry.pending = false;
+}
+
+/** Polled request left queue (completed, timed out or dropped), sensor can be picked again. */
+void PollScheduler::finished(uint8_t code) {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE) { return; }
+
+	entries[idx].pending = false;
+}
+
+// any data request transmitted (polled, sweep, single or retry), for request rate
+void PollScheduler::requested() {
+	requests++;
+}
+
+/** Sensor value observed in response to other device request.
+*
+* Polled sensor is due one interval after observation.
+*/
+void PollScheduler::observed(uint8_t code, uint32_t now) {
+	observed(code, now, passiveMaxAge);
+}
+
+/** Sensor value observed without own request.
+*
+* @param maxAge ms, value is fresh for sweeps, `0` value does not replace requests
+*/
+void PollScheduler::observed(uint8_t code, uint32_t now, uint32_t maxAge) {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE) { return; }
+
+	entries[idx].lastObserved = now;
+	entries[idx].observedMaxAge = maxAge;
+	entries[idx].observed = true;
+	observations++;
+}
+
+/** Sensor value received (polled, sweep or observed), adjust backoff in adaptive mode.
+*
+* @param value raw value, error codes must not be passed
+*/
+void PollScheduler::received(uint8_t code, int16_t value) {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE) { return; }
+
+	Entry& entry = entries[idx];
+	if (entry.hasValue && entry.lastValue == value) {
+		if (entry.backoff < maxBackoff) { entry.backoff++; }
+	} else {
+		entry.backoff = 0;
+	}
+	entry.skipped = 0;
+	entry.lastValue = value;
+	entry.hasValue = true;
+}
+
+/** Should sensor be requested in this sweep.
+*
+* In adaptive mode sensor with backoff `n` is requested every `2^n` sweeps.
+*/
+bool PollScheduler::sweep(uint8_t code) {
+	uint8_t idx = SensorStore::index(code);
+	if (!adaptive || idx == SENSOR_NONE) { return true; }
+
+	Entry& entry = entries[idx];
+	if (entry.skipped + 1 >= (1 << entry.backoff)) { return true; }
+
+	entry.skipped++;
+	return false;
+}
+
+// value observed within its max age, no need to request sensor
+bool PollScheduler::fresh(uint8_t code, uint32_t now) const {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE || !entries[idx].observed) { return false; }
+
+	return now - entries[idx].lastObserved < entries[idx].observedMaxAge;
+}
+
+// restore base period of all sensors (operation or compressor state changed)
+void PollScheduler::wake() {
+	for (Entry& entry : entries) {
+		entry.backoff = 0;
+		entry.skipped = 0;
+	}
+}
+
+bool PollScheduler::polled(uint8_t code) const {
+	return getPeriod(code) != 0;
+}
+
+bool PollScheduler::isAdaptive() const {
+	return adaptive;
+}
+
+uint32_t PollScheduler::getPassiveMaxAge() const {
+	return passiveMaxAge;
+}
+
+uint32_t PollScheduler::getPeriod(uint8_t code) const {
+	uint8_t idx = SensorStore::index(code);
+	return idx == SENSOR_NONE ? 0 : entries[idx].period;
+}
+
+// ms, current interval (period with backoff)
+uint32_t PollScheduler::getInterval(uint8_t code) const {
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE) { return 0; }
+
+	return adaptive ? entries[idx].period << entries[idx].backoff : entries[idx].period;
+}
+
+// ms, last request transmitted after due time
+uint32_t PollScheduler::getLateness(uint8_t code) const {
+	uint8_t idx = SensorStore::index(code);
+	return idx == SENSOR_NONE ? 0 : entries[idx].lastLateness;
+}
+
+uint32_t PollScheduler::getMaxLateness(uint8_t code) const {
+	uint8_t idx = SensorStore::index(code);
+	return idx == SENSOR_NONE ? 0 : entries[idx].maxLateness;
+}
+
+uint32_t PollScheduler::getPolls() const {
+	return polls;
+}
+
+uint32_t PollScheduler::getAverageLateness() const {
+	return polls == 0 ? 0 : totalLateness / polls;
+}
+
+uint32_t PollScheduler::getRequests() const {
+	return requests;
+}
+
+// values observed in responses to other device requests
+uint32_t PollScheduler::getObserved() const {
+	return observations;
+}
+
+/** @return data requests transmitted per minute since `resetStats()` */
+float PollScheduler::getRequestRate(uint32_t now) const {
+	uint32_t elapsed = now - statsStart;
+	return elapsed == 0 ? 0 : requests * 60000.0F / elapsed;
+}
+
+void PollScheduler::resetStats(uint32_t now) {
+	polls = 0;
+	totalLateness = 0;
+	requests = 0;
+	observations = 0;
+	statsStart = now;
+	for (Entry& entry : entries) {
+		entry.maxLateness = 0;
+	}
+}
+
+// one interval after last request or newer passive value
+uint32_t PollScheduler::due(const Entry& entry) const {
+	uint32_t last = entry.lastSent;
+	if (entry.observed && entry.observedMaxAge != 0 && static_cast<int32_t>(entry.lastObserved - last) > 0) { last = entry.lastObserved; }
+
+	return last + (adaptive ? entry.period << entry.backoff : entry.period);
+}
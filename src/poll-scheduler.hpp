@@ -0,0 +1,108 @@
+/*
+poll-scheduler.hpp - Estia R32 heat pump periodic sensors data requests
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "sensor-store.hpp"
+
+#define POLL_ADAPTIVE_MAX_BACKOFF 3    // stable sensor interval up to period << 3 (x8)
+#define POLL_PASSIVE_MAX_AGE 10000     // ms, passive value fresh enough to skip sensor in sweep
+
+/** Per sensor polling periods and priorities.
+*
+* Every sensor (indexed as in `SensorStore`) can have own period and priority.
+* `next()` picks due sensor with highest priority (most overdue first on tie),
+* lateness (transmit time - due time) is recorded when request is sent.
+*
+* In adaptive mode every unchanged reading doubles sensor interval (backoff)
+* up to `period << maxBackoff`, changed value or `wake()` (operation state change)
+* restores base period. Sweeps (`requestSensorsData()`) skip stable sensors the same way.
+*
+* Values observed in responses to other device requests (remote controller) count as
+* polls, sensor is due one interval after observation. Sweeps skip sensors observed
+* within `passiveMaxAge` (or max age given with observation, e.g. status frame). Times in ms.
+*/
+class PollScheduler {
+  public:
+	enum Priority : uint8_t {
+		priority_low,
+		priority_normal,
+		priority_high,
+	};
+
+  private:
+	struct Entry {
+		uint32_t period;    // 0 not polled
+		uint32_t lastSent;
+		uint32_t lastLateness;
+		uint32_t maxLateness;
+		uint32_t lastObserved;    // passive value
+		uint32_t observedMaxAge;    // 0 observed value does not replace request
+		int16_t lastValue;
+		Priority priority;
+		uint8_t backoff;    // interval = period << backoff
+		uint8_t skipped;    // sweeps skipped at current backoff
+		bool hasValue;
+		bool observed;
+		bool pending;    // picked by next(), not sent yet or still queued
+	};
+
+	Entry entries[SENSORS_COUNT];
+	bool adaptive;
+	uint8_t maxBackoff;
+	uint32_t passiveMaxAge;
+	uint32_t polls;
+	uint32_t totalLateness;
+	uint32_t requests;
+	uint32_t observations;
+	uint32_t statsStart;
+
+	uint32_t due(const Entry& entry) const;
+
+  public:
+	PollScheduler();
+
+	bool setPeriod(uint8_t code, uint32_t period, Priority priority, uint32_t now);
+	void disable(uint8_t code);
+	void clear();
+	void setAdaptive(bool enable, uint8_t maxBackoff = POLL_ADAPTIVE_MAX_BACKOFF);
+	void setPassiveMaxAge(uint32_t maxAge);
+	uint8_t next(uint32_t now);
+	void sent(uint8_t code, uint32_t now);
+	void finished(uint8_t code);
+	void requested();
+	void received(uint8_t code, int16_t value);
+	void observed(uint8_t code, uint32_t now);
+	void observed(uint8_t code, uint32_t now, uint32_t maxAge);
+	bool sweep(uint8_t code);
+	bool fresh(uint8_t code, uint32_t now) const;
+	void wake();
+	bool polled(uint8_t code) const;
+	bool isAdaptive() const;
+	uint32_t getPassiveMaxAge() const;
+	uint32_t getPeriod(uint8_t code) const;
+	uint32_t getInterval(uint8_t code) const;
+	uint32_t getLateness(uint8_t code) const;
+	uint32_t getMaxLateness(uint8_t code) const;
+	uint32_t getPolls() const;
+	uint32_t getAverageLateness() const;
+	uint32_t getRequests() const;
+	uint32_t getObserved() const;
+	float getRequestRate(uint32_t now) const;
+	void resetStats(uint32_t now);
+};
@@ -0,0 +1,273 @@
+/*
+sensor-history.cpp - Estia R32 heat pump sensors data history
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "sensor-history.hpp"
+
+#define HISTORY_ESCAPE 0x80
+
+static uint32_t zigzag(int32_t value) {
+	return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+	return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+static size_t writeVarint(uint32_t value, uint8_t* out) {
+	size_t len = 0;
+	while (value >= 0x80) {
+		out[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	out[len++] = value;
+	return len;
+}
+
+HistoryRing::const_iterator::const_iterator(const HistoryRing* ring, size_t idx)
+    : ring(ring)
+    , idx(idx)
+    , pos(ring->tail)
+    , state(ring->first) {
+}
+
+HistoryRing::Sample HistoryRing::const_iterator::operator*() const {
+	return {state.time * HISTORY_TIME_UNIT, state.value};
+}
+
+HistoryRing::const_iterator& HistoryRing::const_iterator::operator++() {
+	idx++;
+	if (idx < ring->count) { pos = (pos + ring->decode(pos, state)) % ring->capacity; }
+	return *this;
+}
+
+bool HistoryRing::const_iterator::operator!=(const const_iterator& other) const {
+	return idx != other.idx;
+}
+
+HistoryRing::HistoryRing()
+    : data(nullptr)
+    , capacity(0)
+    , tail(0)
+    , used(0)
+    , count(0)
+    , first()
+    , last() {
+}
+
+HistoryRing::~HistoryRing() {
+	delete[] data;
+}
+
+/** Allocate ring once.
+*
+* @param bytes ring size, at least `HISTORY_RECORD_MAX`
+*/
+bool HistoryRing::allocate(size_t bytes) {
+	if (data != nullptr || bytes < HISTORY_RECORD_MAX) { return false; }
+
+	data = new uint8_t[bytes];
+	capacity = bytes;
+	return true;
+}
+
+/**
+* @param time ms
+* @param value raw value
+*/
+void HistoryRing::append(uint32_t time, int16_t value) {
+	if (data == nullptr) { return; }
+
+	State sample = {time / HISTORY_TIME_UNIT, 0, value};
+	if (count == 0) {
+		first = sample;
+		last = sample;
+		count = 1;
+		return;
+	}
+	sample.interval = static_cast<int32_t>(sample.time - last.time);
+	uint8_t record[HISTORY_RECORD_MAX];
+	size_t len = encode(sample.interval - last.interval, value - last.value, record);
+	while (capacity - used < len) {
+		dropOldest();
+	}
+	size_t head = (tail + used) % capacity;
+	for (size_t idx = 0; idx < len; idx++) {
+		data[(head + idx) % capacity] = record[idx];
+	}
+	used += len;
+	count++;
+	last = sample;
+}
+
+void HistoryRing::clear() {
+	tail = 0;
+	used = 0;
+	count = 0;
+}
+
+size_t HistoryRing::size() const {
+	return count;
+}
+
+bool HistoryRing::empty() const {
+	return count == 0;
+}
+
+// Bytes used by records (oldest sample is kept outside ring)
+size_t HistoryRing::bytes() const {
+	return used;
+}
+
+size_t HistoryRing::getCapacity() const {
+	return capacity;
+}
+
+HistoryRing::Sample HistoryRing::newest() const {
+	return {last.time * HISTORY_TIME_UNIT, last.value};
+}
+
+// oldest to newest
+HistoryRing::const_iterator HistoryRing::begin() const {
+	return const_iterator(this, 0);
+}
+
+HistoryRing::const_iterator HistoryRing::end() const {
+	return const_iterator(this, count);
+}
+
+/** Call `callback` for newest `samples` (oldest of them first). */
+void HistoryRing::latest(size_t samples, HistoryCallback callback) const {
+	size_t skip = samples < count ? count - samples : 0;
+	for (const_iterator it = begin(); it != end(); ++it) {
+		if (skip > 0) {
+			skip--;
+			continue;
+		}
+		Sample sample = *it;
+		callback(sample.time, sample.value);
+	}
+}
+
+/** Call `callback` for samples with time in `from`-`to` (ms, inclusive). */
+void HistoryRing::range(uint32_t from, uint32_t to, HistoryCallback callback) const {
+	for (const_iterator it = begin(); it != end(); ++it) {
+		Sample sample = *it;
+		if (static_cast<int32_t>(sample.time - from) < 0) { continue; }
+		if (static_cast<int32_t>(sample.time - to) > 0) { break; }
+		callback(sample.time, sample.value);
+	}
+}
+
+uint8_t HistoryRing::byteAt(size_t pos) const {
+	return data[pos % capacity];
+}
+
+// decode record at `pos` into `state` (previous sample becomes next one), return record length
+size_t HistoryRing::decode(size_t pos, State& state) const {
+	uint8_t head = byteAt(pos);
+	int32_t timeDod;
+	int32_t valueDelta;
+	size_t len = 1;
+	if (head != HISTORY_ESCAPE) {
+		timeDod = static_cast<int8_t>(head << 1) >> 5;     // bits 6..4, sign extended
+		valueDelta = static_cast<int8_t>(head << 4) >> 4;  // bits 3..0, sign extended
+	} else {
+		uint32_t varint[2] = {0, 0};
+		for (uint32_t& value : varint) {
+			uint8_t shift = 0;
+			uint8_t byte;
+			do {
+				byte = byteAt(pos + len++);
+				value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+				shift += 7;
+			} while (byte & 0x80);
+		}
+		timeDod = unzigzag(varint[0]);
+		valueDelta = unzigzag(varint[1]);
+	}
+	state.interval += timeDod;
+	state.time += state.interval;
+	state.value += valueDelta;
+	return len;
+}
+
+size_t HistoryRing::encode(int32_t timeDod, int32_t valueDelta, uint8_t* out) {
+	if (timeDod >= -4 && timeDod <= 3 && valueDelta >= -8 && valueDelta <= 7) {
+		out[0] = ((timeDod & 0x07) << 4) | (valueDelta & 0x0f);
+		return 1;
+	}
+	size_t len = 0;
+	out[len++] = HISTORY_ESCAPE;
+	len += writeVarint(zigzag(timeDod), out + len);
+	len += writeVarint(zigzag(valueDelta), out + len);
+	return len;
+}
+
+// oldest record becomes absolute oldest sample
+void HistoryRing::dropOldest() {
+	if (used == 0) { return; }
+
+	size_t len = decode(tail, first);
+	tail = (tail + len) % capacity;
+	used -= len;
+	count--;
+}
+
+SensorHistory::SensorHistory()
+    : codes()
+    , rings()
+    , tracked(0)
+    , allocated(0) {
+}
+
+/** Keep history of sensor.
+*
+* @param code data code
+* @param bytes ring size, e.g. 24h of 10s polling of slowly changing value fits ~8.7 kB
+* @return false for unknown code, sensors limit or memory budget exceeded
+*/
+bool SensorHistory::track(uint8_t code, size_t bytes) {
+	if (SensorStore::index(code) == SENSOR_NONE || ring(code) != nullptr) { return false; }
+	if (tracked >= HISTORY_SENSORS_LIMIT || allocated + bytes > HISTORY_MEMORY_BUDGET) { return false; }
+	if (!rings[tracked].allocate(bytes)) { return false; }
+
+	codes[tracked++] = code;
+	allocated += bytes;
+	return true;
+}
+
+void SensorHistory::append(uint8_t code, uint32_t time, int16_t value) {
+	for (uint8_t idx = 0; idx < tracked; idx++) {
+		if (codes[idx] == code) {
+			rings[idx].append(time, value);
+			return;
+		}
+	}
+}
+
+/** @return `nullptr` for not tracked sensor */
+const HistoryRing* SensorHistory::ring(uint8_t code) const {
+	for (uint8_t idx = 0; idx < tracked; idx++) {
+		if (codes[idx] == code) { return &rings[idx]; }
+	}
+	return nullptr;
+}
+
+size_t SensorHistory::getAllocated() const {
+	return allocated;
+}
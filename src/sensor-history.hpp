@@ -0,0 +1,116 @@
+/*
+sensor-history.hpp - Estia R32 heat pump sensors data history
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "sensor-store.hpp"
+#include <functional>
+
+#define HISTORY_TIME_UNIT 1000          // ms, stored time resolution
+#define HISTORY_RECORD_MAX 11           // escape byte + 2 varints
+#define HISTORY_SENSORS_LIMIT 8         // sensors with history
+#define HISTORY_MEMORY_BUDGET 16384     // Bytes, all history rings together
+
+using HistoryCallback = std::function<void(uint32_t time, int16_t value)>;
+
+/** Delta encoded samples of single sensor in fixed size byte ring.
+*
+* Oldest sample is kept as absolute value, every next one is a record with
+* time delta-of-delta (`HISTORY_TIME_UNIT`) and value delta:
+* - `0ttt vvvv` time dod -4..3 and value delta -8..7 in one Byte (regular polling, slow changes)
+* - `1000 0000` followed by zigzag varint time dod and zigzag varint value delta
+*
+* When ring is full oldest samples are dropped (decoded into new absolute oldest sample).
+*/
+class HistoryRing {
+  public:
+	struct Sample {
+		uint32_t time;    // ms
+		int16_t value;
+	};
+
+  private:
+	struct State {
+		uint32_t time;        // HISTORY_TIME_UNIT
+		int32_t interval;     // HISTORY_TIME_UNIT, previous sample to this one
+		int16_t value;
+	};
+
+	uint8_t* data;
+	size_t capacity;
+	size_t tail;    // oldest record
+	size_t used;
+	size_t count;
+	State first;
+	State last;
+
+	uint8_t byteAt(size_t pos) const;
+	size_t decode(size_t pos, State& state) const;
+	static size_t encode(int32_t timeDod, int32_t valueDelta, uint8_t* out);
+	void dropOldest();
+
+  public:
+	class const_iterator {
+	  private:
+		const HistoryRing* ring;
+		size_t idx;
+		size_t pos;
+		State state;
+
+	  public:
+		const_iterator(const HistoryRing* ring, size_t idx);
+		Sample operator*() const;
+		const_iterator& operator++();
+		bool operator!=(const const_iterator& other) const;
+	};
+
+	HistoryRing();
+	~HistoryRing();
+	HistoryRing(const HistoryRing&) = delete;
+	HistoryRing& operator=(const HistoryRing&) = delete;
+
+	bool allocate(size_t bytes);
+	void append(uint32_t time, int16_t value);
+	void clear();
+	size_t size() const;
+	bool empty() const;
+	size_t bytes() const;
+	size_t getCapacity() const;
+	Sample newest() const;
+	const_iterator begin() const;
+	const_iterator end() const;
+	void latest(size_t samples, HistoryCallback callback) const;
+	void range(uint32_t from, uint32_t to, HistoryCallback callback) const;
+};
+
+/** History rings of chosen sensors, memory limited by `HISTORY_MEMORY_BUDGET`. */
+class SensorHistory {
+  private:
+	uint8_t codes[HISTORY_SENSORS_LIMIT];
+	HistoryRing rings[HISTORY_SENSORS_LIMIT];
+	uint8_t tracked;
+	size_t allocated;
+
+  public:
+	SensorHistory();
+
+	bool track(uint8_t code, size_t bytes);
+	void append(uint8_t code, uint32_t time, int16_t value);
+	const HistoryRing* ring(uint8_t code) const;
+	size_t getAllocated() const;
+};
@@ -0,0 +1,243 @@
+/*
+sensor-store.cpp - Estia R32 heat pump sensors data storage
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "sensor-store.hpp"
+
+// single source of sensors catalog, `requestsMap` and index table are generated from it
+static constexpr SensorDescriptor sensorDescriptors[] PROGMEM = {
+    {CODE_TC, "tc", 1, "°C"},
+    {CODE_TWI, "twi", 1, "°C"},
+    {CODE_TWO, "two", 1, "°C"},
+    {CODE_THO, "tho", 1, "°C"},
+    {CODE_TFI, "tfi", 1, "°C"},
+    {CODE_TTW, "ttw", 1, "°C"},
+    {CODE_MIX, "mix", 1, "step"},
+    {CODE_LPS, "lps", 10, "kPa"},
+    {CODE_SW_VER, "sw_ver", 1, ""},
+    {CODE_CTRL_HW_TEMP, "ctrl_hw_temp", 1, "°C"},
+    {CODE_CTRL_ZONE1_TEMP, "ctrl_zone1_temp", 1, "°C"},
+    {CODE_CTRL_ZONE2_TEMP, "ctrl_zone2_temp", 1, "°C"},
+    {CODE_WF, "wf", 0.1F, "l/min"},
+    {CODE_TE, "te", 1, "°C"},
+    {CODE_TO, "to", 1, "°C"},
+    {CODE_TD, "td", 1, "°C"},
+    {CODE_TS, "ts", 1, "°C"},
+    {CODE_THS, "ths", 1, "°C"},
+    {CODE_CT, "ct", 10, "A"},
+    {CODE_TL, "tl", 1, "°C"},
+    {CODE_CMP, "cmp", 1, "Hz"},
+    {CODE_FAN1, "fan1", 1, "RPM"},
+    {CODE_FAN2, "fan2", 1, "RPM"},
+    {CODE_PMV, "pmv", 10, "pls"},
+    {CODE_HPS, "hps", 10, "kPa"},
+    {CODE_HP_ON_TIME, "hp_on_time", 100, "h"},
+    {CODE_HW_CMP_ON_TIME, "hw_cmp_on_time", 100, "h"},
+    {CODE_COOL_CMP_ON_TIME, "cool_cmp_on_time", 100, "h"},
+    {CODE_HEAT_CMP_ON_TIME, "heat_cmp_on_time", 100, "h"},
+    {CODE_PUMP1_ON_TIME, "pump1_on_time", 100, "h"},
+    {CODE_HW_E_HEATER_ON_TIME, "hw_e_heater_on_time", 100, "h"},
+    {CODE_BACKUP_HEATER_ON_TIME, "backup_heater_on_time", 100, "h"},
+    {CODE_BOOST_HEATER_ON_TIME, "boost_heater_on_time", 100, "h"},
+};
+
+static_assert(sizeof(sensorDescriptors) / sizeof(SensorDescriptor) == SENSORS_COUNT, "SENSORS_COUNT does not match descriptor table");
+
+// descriptor names sorted at compile time (binary search)
+static constexpr RequestsMap generateRequestsMap() {
+	RequestsMap map = {};
+	for (uint8_t idx = 0; idx < SENSORS_COUNT; idx++) {
+		CatalogEntry<uint8_t> entry = {};
+		for (uint8_t pos = 0; pos < CATALOG_NAME_SIZE; pos++) {
+			entry.name[pos] = sensorDescriptors[idx].name[pos];
+		}
+		entry.value = sensorDescriptors[idx].code;
+		uint8_t pos = idx;
+		for (; pos > 0 && RequestsMap::compare(map.entries[pos - 1].name, entry.name) > 0; pos--) {
+			map.entries[pos] = map.entries[pos - 1];
+		}
+		map.entries[pos] = entry;
+	}
+	return map;
+}
+
+constexpr RequestsMap requestsMap PROGMEM = generateRequestsMap();
+static_assert(requestsMap.sorted(), "duplicated name in sensors descriptor table");
+
+struct SensorIndexTable {
+	uint8_t index[256];
+	bool duplicate;
+
+	constexpr SensorIndexTable()
+	    : index()
+	    , duplicate(false) {
+		for (uint8_t& idx : index) {
+			idx = SENSOR_NONE;
+		}
+		for (uint8_t idx = 0; idx < SENSORS_COUNT; idx++) {
+			uint8_t& slot = index[sensorDescriptors[idx].code];
+			if (slot != SENSOR_NONE) { duplicate = true; }
+			slot = idx;
+		}
+	}
+};
+
+static constexpr SensorIndexTable sensorIndex PROGMEM = SensorIndexTable();
+static_assert(!sensorIndex.duplicate, "duplicated data code in sensors descriptor table");
+
+float SensorStore::Reading::scaled() const {
+	return value * descriptor.multiplier;
+}
+
+SensorStore::const_iterator::const_iterator(const SensorStore* store, uint8_t idx)
+    : store(store)
+    , idx(idx) {
+}
+
+SensorStore::Reading SensorStore::const_iterator::operator*() const {
+	return store->at(idx);
+}
+
+SensorStore::const_iterator& SensorStore::const_iterator::operator++() {
+	idx = store->nextUsed(idx + 1);
+	return *this;
+}
+
+bool SensorStore::const_iterator::operator!=(const const_iterator& other) const {
+	return idx != other.idx;
+}
+
+SensorStore::SensorStore()
+    : values()
+    , states()
+    , updateTimes()
+    , passiveFlags() {
+}
+
+/** @return index in descriptor table, `SENSOR_NONE` for unknown code */
+uint8_t SensorStore::index(uint8_t code) {
+	return pgm_read_byte(&sensorIndex.index[code]);
+}
+
+uint8_t SensorStore::index(const std::string& name) {
+	uint8_t code;
+	if (!requestsMap.find(name.c_str(), code)) { return SENSOR_NONE; }
+
+	return index(code);
+}
+
+SensorDescriptor SensorStore::descriptor(uint8_t idx) {
+	SensorDescriptor descriptor;
+	memcpy_P(&descriptor, &sensorDescriptors[idx], sizeof(SensorDescriptor));
+	return descriptor;
+}
+
+/** Data multiplier by name, replaces `requestsMap.at(name).multiplier`.
+* @return `0` for unknown name
+*/
+float SensorStore::multiplier(const std::string& name) {
+	uint8_t idx = index(name);
+	return idx == SENSOR_NONE ? 0 : pgm_read_float(&sensorDescriptors[idx].multiplier);
+}
+
+/**
+* @param code data code
+* @param value raw value or error code
+* @param time update time (ms)
+* @param error value is error code
+* @param passive value observed without own request
+* @return false for unknown code
+*/
+bool SensorStore::set(uint8_t code, int16_t value, uint32_t time, bool error, bool passive) {
+	uint8_t idx = index(code);
+	if (idx == SENSOR_NONE) { return false; }
+
+	values[idx] = value;
+	states[idx] = error ? sensor_error : sensor_valid;
+	updateTimes[idx] = time;
+	passiveFlags[idx] = passive;
+	return true;
+}
+
+void SensorStore::clear() {
+	for (State& state : states) {
+		state = sensor_empty;
+	}
+}
+
+bool SensorStore::has(uint8_t code) const {
+	return state(code) != sensor_empty;
+}
+
+int16_t SensorStore::value(uint8_t code) const {
+	uint8_t idx = index(code);
+	return idx == SENSOR_NONE ? 0 : values[idx];
+}
+
+float SensorStore::scaled(uint8_t code) const {
+	uint8_t idx = index(code);
+	return idx == SENSOR_NONE ? 0 : values[idx] * pgm_read_float(&sensorDescriptors[idx].multiplier);
+}
+
+SensorStore::State SensorStore::state(uint8_t code) const {
+	uint8_t idx = index(code);
+	return idx == SENSOR_NONE ? sensor_empty : states[idx];
+}
+
+uint32_t SensorStore::updated(uint8_t code) const {
+	uint8_t idx = index(code);
+	return idx == SENSOR_NONE ? 0 : updateTimes[idx];
+}
+
+// last value was observed without own request (other device request, status frame)
+bool SensorStore::passive(uint8_t code) const {
+	uint8_t idx = index(code);
+	return idx == SENSOR_NONE ? false : passiveFlags[idx];
+}
+
+/** @param idx index in descriptor table */
+SensorStore::Reading SensorStore::at(uint8_t idx) const {
+	return {descriptor(idx), values[idx], states[idx], updateTimes[idx], passiveFlags[idx]};
+}
+
+size_t SensorStore::size() const {
+	size_t count = 0;
+	for (State state : states) {
+		if (state != sensor_empty) { count++; }
+	}
+	return count;
+}
+
+bool SensorStore::empty() const {
+	return nextUsed(0) == SENSORS_COUNT;
+}
+
+// iteration skips sensors without data
+SensorStore::const_iterator SensorStore::begin() const {
+	return const_iterator(this, nextUsed(0));
+}
+
+SensorStore::const_iterator SensorStore::end() const {
+	return const_iterator(this, SENSORS_COUNT);
+}
+
+uint8_t SensorStore::nextUsed(uint8_t idx) const {
+	while (idx < SENSORS_COUNT && states[idx] == sensor_empty) {
+		idx++;
+	}
+	return idx;
+}
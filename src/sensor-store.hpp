@@ -0,0 +1,106 @@
+/*
+sensor-store.hpp - Estia R32 heat pump sensors data storage
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "frames/data-frames.hpp"
+
+#define SENSORS_COUNT REQUESTS_COUNT    // entries in sensors descriptor table
+#define SENSOR_NONE 0xff                // sensor index of unknown data code
+#define SENSOR_UNIT_SIZE 6              // longest unit + terminator
+
+/**
+* @param code data code
+* @param name data name (`requestsMap` is generated from descriptors)
+* @param multiplier data modifier
+* @param unit data unit, empty when value has no unit
+*/
+struct SensorDescriptor {
+	uint8_t code;
+	char name[CATALOG_NAME_SIZE];
+	float multiplier;
+	char unit[SENSOR_UNIT_SIZE];
+};
+
+/** Sensors data indexed by data code.
+*
+* Values, states and update times are kept in fixed arrays ordered as static
+* descriptor table (name, multiplier, unit, flash), data code is mapped to index by
+* 256 Bytes lookup table (flash). No allocation, iterating is a linear scan.
+* Descriptors are read from flash into copies.
+*/
+class SensorStore {
+  public:
+	enum State : uint8_t {
+		sensor_empty,
+		sensor_valid,
+		sensor_error,    // value is error code
+	};
+
+	/** Single sensor, valid until store is changed. */
+	struct Reading {
+		SensorDescriptor descriptor;    // copy from flash
+		int16_t value;
+		State state;
+		uint32_t updated;
+		bool passive;    // not requested by library (other device request, status frame)
+
+		float scaled() const;
+	};
+
+	class const_iterator {
+	  private:
+		const SensorStore* store;
+		uint8_t idx;
+
+	  public:
+		const_iterator(const SensorStore* store, uint8_t idx);
+		Reading operator*() const;
+		const_iterator& operator++();
+		bool operator!=(const const_iterator& other) const;
+	};
+
+  private:
+	int16_t values[SENSORS_COUNT];
+	State states[SENSORS_COUNT];
+	uint32_t updateTimes[SENSORS_COUNT];    // ms
+	bool passiveFlags[SENSORS_COUNT];
+
+	uint8_t nextUsed(uint8_t idx) const;
+
+  public:
+	SensorStore();
+
+	static uint8_t index(uint8_t code);
+	static uint8_t index(const std::string& name);
+	static SensorDescriptor descriptor(uint8_t idx);
+	static float multiplier(const std::string& name);
+	bool set(uint8_t code, int16_t value, uint32_t time, bool error = false, bool passive = false);
+	void clear();
+	bool has(uint8_t code) const;
+	int16_t value(uint8_t code) const;
+	float scaled(uint8_t code) const;
+	State state(uint8_t code) const;
+	uint32_t updated(uint8_t code) const;
+	bool passive(uint8_t code) const;
+	Reading at(uint8_t idx) const;
+	size_t size() const;
+	bool empty() const;
+	const_iterator begin() const;
+	const_iterator end() const;
+};
@@ -0,0 +1,184 @@
+/*
+linux-serial-transport.cpp - Estia R32 heat pump Linux serial port transport
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "linux-serial-transport.hpp"
+
+#ifdef ESTIA_TRANSPORT_LINUX
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+LinuxSerialTransport::LinuxSerialTransport(const char* device, bool echo)
+    : device(device)
+    , fd(-1)
+    , rxEnabled(true)
+    , echo(echo)
+    , echoExpected()
+    , echoLen(0)
+    , echoPos(0)
+    , echoDeadline(0) {
+}
+
+LinuxSerialTransport::~LinuxSerialTransport() {
+	end();
+}
+
+bool LinuxSerialTransport::begin() {
+	end();
+	fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (fd < 0) { return false; }
+
+	struct termios tty;
+	if (tcgetattr(fd, &tty) != 0) {
+		end();
+		return false;
+	}
+	cfmakeraw(&tty);
+	cfsetispeed(&tty, B2400);
+	cfsetospeed(&tty, B2400);
+	tty.c_cflag &= ~(CSIZE | PARODD | CSTOPB | CRTSCTS);
+	tty.c_cflag |= CS8 | PARENB | CLOCAL | CREAD;    // 8E1
+	tty.c_iflag &= ~(IXON | IXOFF | IXANY);
+	tty.c_cc[VMIN] = 0;    // non-blocking read
+	tty.c_cc[VTIME] = 0;
+	if (tcsetattr(fd, TCSANOW, &tty) != 0) {
+		end();
+		return false;
+	}
+	tcflush(fd, TCIOFLUSH);
+	return true;
+}
+
+void LinuxSerialTransport::end() {
+	if (fd < 0) { return; }
+
+	close(fd);
+	fd = -1;
+}
+
+size_t LinuxSerialTransport::available() {
+	int count = 0;
+	if (fd < 0 || ioctl(fd, FIONREAD, &count) != 0 || count < 0) { return 0; }
+	return count;
+}
+
+size_t LinuxSerialTransport::read(uint8_t* buffer, size_t len) {
+	if (fd < 0) { return 0; }
+
+	ssize_t count = ::read(fd, buffer, len);
+	if (count <= 0) {
+		// line silent after echo should have arrived, echo is lost
+		if (echoPos != echoLen && static_cast<int32_t>(timestamp() - echoDeadline) > 0) { echoPos = echoLen; }
+		return 0;
+	}
+	size_t received = dropEcho(buffer, count);
+	if (!rxEnabled) { return 0; }    // drop bytes received while RX is disabled
+	return received;
+}
+
+size_t LinuxSerialTransport::write(const uint8_t* buffer, size_t len) {
+	if (fd < 0) { return 0; }
+
+	size_t written = 0;
+	while (written < len) {
+		ssize_t count = ::write(fd, buffer + written, len - written);
+		if (count < 0) {
+			if (errno != EAGAIN && errno != EINTR) { break; }
+			struct pollfd pfd = {fd, POLLOUT, 0};
+			poll(&pfd, 1, 10);
+			continue;
+		}
+		written += count;
+	}
+	if (echo) { expectEcho(buffer, written); }
+	return written;
+}
+
+/** Record written bytes, echo is matched by `read()` as it arrives, write does not wait for it.
+*
+* Bytes not fitting `LINUX_SERIAL_ECHO_SIZE` are passed as received.
+*/
+void LinuxSerialTransport::expectEcho(const uint8_t* buffer, size_t len) {
+	if (echoPos == echoLen) {
+		echoPos = 0;
+		echoLen = 0;
+	}
+	if (len > LINUX_SERIAL_ECHO_SIZE - echoLen) { len = LINUX_SERIAL_ECHO_SIZE - echoLen; }
+	memcpy(echoExpected + echoLen, buffer, len);
+	echoLen += len;
+	echoDeadline = timestamp() + (echoLen - echoPos) * ESTIA_SERIAL_CHAR_TIME + LINUX_SERIAL_ECHO_TIMEOUT * 1000UL;
+}
+
+/** Drop received bytes matching expected echo.
+*
+* Byte not matching means other device or collision, matching stops and bytes of this read are kept.
+* @return bytes left at `buffer` start
+*/
+size_t LinuxSerialTransport::dropEcho(uint8_t* buffer, size_t len) {
+	size_t matched = 0;
+	while (matched < len && echoPos + matched < echoLen && buffer[matched] == echoExpected[echoPos + matched]) { matched++; }
+	if (matched < len && echoPos + matched < echoLen) {
+		echoPos = echoLen;
+		return len;
+	}
+	echoPos += matched;
+	if (matched != 0) { memmove(buffer, buffer + matched, len - matched); }
+	return len - matched;
+}
+
+void LinuxSerialTransport::enableTx(bool enable) {
+	// direction is switched by adapter
+	(void)enable;
+}
+
+void LinuxSerialTransport::enableRx(bool enable) {
+	rxEnabled = enable;
+}
+
+void LinuxSerialTransport::flushRx() {
+	// own echo is dropped by read() as it arrives, other received bytes are kept
+}
+
+uint32_t LinuxSerialTransport::timestamp() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<uint32_t>(now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+}
+
+/** Sleep until data is received (gateway main loop).
+*
+* @param timeout poll() timeout ms, `-1` wait forever
+*/
+bool LinuxSerialTransport::waitAvailable(int timeout) {
+	if (fd < 0) { return false; }
+
+	struct pollfd pfd = {fd, POLLIN, 0};
+	return poll(&pfd, 1, timeout) > 0 && (pfd.revents & POLLIN);
+}
+
+int LinuxSerialTransport::getFd() const {
+	return fd;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+linux-serial-transport.hpp - Estia R32 heat pump Linux serial port transport
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "transport.hpp"
+
+#ifdef ESTIA_TRANSPORT_LINUX
+
+#define LINUX_SERIAL_ECHO_TIMEOUT 50    // ms, echo delay after transmit end (USB adapter latency timer)
+#define LINUX_SERIAL_ECHO_SIZE 64       // written bytes waiting for echo
+
+/** Linux tty transport (USB-RS485 adapter, pty), termios 8E1 2400 baud.
+*
+* Adapter is expected to switch bus direction on its own.
+* @param device tty path e.g. `/dev/ttyUSB0`
+* @param echo adapter receives own transmitted bytes, received bytes matching written ones are dropped
+*/
+class LinuxSerialTransport : public Transport {
+  private:
+	const char* device;
+	int fd;
+	bool rxEnabled;
+	bool echo;
+	uint8_t echoExpected[LINUX_SERIAL_ECHO_SIZE];    // written bytes, not received back yet from `echoPos`
+	size_t echoLen;
+	size_t echoPos;
+	uint32_t echoDeadline;    // us, echo is lost when line is silent after it
+
+	void expectEcho(const uint8_t* buffer, size_t len);
+	size_t dropEcho(uint8_t* buffer, size_t len);
+
+  public:
+	LinuxSerialTransport(const char* device, bool echo = false);
+	~LinuxSerialTransport();
+
+	bool begin() override;
+	void end();
+	size_t available() override;
+	size_t read(uint8_t* buffer, size_t len) override;
+	size_t write(const uint8_t* buffer, size_t len) override;
+	void enableTx(bool enable) override;
+	void enableRx(bool enable) override;
+	void flushRx() override;
+	uint32_t timestamp() override;
+	bool waitAvailable(int timeout);
+	int getFd() const;
+};
+
+#endif
@@ -0,0 +1,81 @@
+/*
+software-serial-transport.cpp - Estia R32 heat pump SoftwareSerial transport
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "software-serial-transport.hpp"
+
+#ifdef ESTIA_TRANSPORT_SOFTWARE_SERIAL
+
+SoftwareSerial softwareSerial;
+
+SoftwareSerialTransport::SoftwareSerialTransport(SoftwareSerial& serial, int8_t rxPin, int8_t txPin)
+    : serial(&serial)
+    , rxPin(rxPin)
+    , txPin(txPin) {
+}
+
+void SoftwareSerialTransport::setPins(int8_t rxPin, int8_t txPin) {
+	this->rxPin = rxPin;
+	this->txPin = txPin;
+}
+
+bool SoftwareSerialTransport::begin() {
+	serial->begin(ESTIA_SERIAL_BAUD, ESTIA_SERIAL_CONFIG, rxPin, txPin);
+	serial->enableIntTx(false);    //disable TX
+	return true;
+}
+
+size_t SoftwareSerialTransport::available() {
+	return serial->available();
+}
+
+size_t SoftwareSerialTransport::read(uint8_t* buffer, size_t len) {
+	size_t count = 0;
+	if (!serial->available()) { return 0; }    // LED shows RX activity only
+
+	digitalWrite(LED_BUILTIN, LOW);
+	while (count < len && serial->available()) {
+		buffer[count++] = serial->read();
+	}
+	digitalWrite(LED_BUILTIN, HIGH);
+	return count;
+}
+
+size_t SoftwareSerialTransport::write(const uint8_t* buffer, size_t len) {
+	digitalWrite(LED_BUILTIN, LOW);
+	size_t written = serial->write(buffer, len);
+	digitalWrite(LED_BUILTIN, HIGH);
+	return written;
+}
+
+void SoftwareSerialTransport::enableTx(bool enable) {
+	serial->enableIntTx(enable);
+}
+
+void SoftwareSerialTransport::enableRx(bool enable) {
+	serial->enableRx(enable);
+}
+
+void SoftwareSerialTransport::flushRx() {
+	serial->flush();    // empty serial RX buffer
+}
+
+uint32_t SoftwareSerialTransport::timestamp() {
+	return micros();
+}
+
+#endif
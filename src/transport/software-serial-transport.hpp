@@ -0,0 +1,56 @@
+/*
+software-serial-transport.hpp - Estia R32 heat pump SoftwareSerial transport
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "transport.hpp"
+
+#ifdef ESTIA_TRANSPORT_SOFTWARE_SERIAL
+
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+
+#define ESTIA_SERIAL_CONFIG SWSERIAL_8E1    // 8E1
+#ifdef ARDUINO_ARCH_ESP32
+#define LED_BUILTIN 0
+#endif
+
+extern SoftwareSerial softwareSerial;
+
+/** EspSoftwareSerial transport, builtin LED is on during bus activity. */
+class SoftwareSerialTransport : public Transport {
+  private:
+	SoftwareSerial* serial;
+	int8_t rxPin;
+	int8_t txPin;
+
+  public:
+	SoftwareSerialTransport(SoftwareSerial& serial = softwareSerial, int8_t rxPin = -1, int8_t txPin = -1);
+
+	void setPins(int8_t rxPin, int8_t txPin);
+	bool begin() override;
+	size_t available() override;
+	size_t read(uint8_t* buffer, size_t len) override;
+	size_t write(const uint8_t* buffer, size_t len) override;
+	void enableTx(bool enable) override;
+	void enableRx(bool enable) override;
+	void flushRx() override;
+	uint32_t timestamp() override;
+};
+
+#endif
@@ -0,0 +1,56 @@
+/*
+transport.hpp - Estia R32 heat pump serial transport interface
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ESTIA_SERIAL_BAUD 2400                                     // 2400, 8E1
+#define ESTIA_SERIAL_CHAR_TIME (11 * 1000000UL / ESTIA_SERIAL_BAUD)    // us, start + 8 data + parity + stop bits
+
+#if defined(ARDUINO)
+#define ESTIA_TRANSPORT_SOFTWARE_SERIAL
+#elif defined(__linux__)
+#define ESTIA_TRANSPORT_LINUX
+#endif
+
+/** Serial line used by EstiaSerial.
+*
+* All calls must return immediately, `read()` returns only bytes already received.
+*/
+class Transport {
+  public:
+	virtual ~Transport() {}
+
+	virtual bool begin() = 0;
+	virtual size_t available() = 0;
+	/** Read already received bytes, never waits.
+	*
+	* @return number of bytes copied to `buffer`
+	*/
+	virtual size_t read(uint8_t* buffer, size_t len) = 0;
+	virtual size_t write(const uint8_t* buffer, size_t len) = 0;
+	/** Line direction control (half duplex bus). */
+	virtual void enableTx(bool enable) = 0;
+	virtual void enableRx(bool enable) = 0;
+	/** Discard bytes received during transmit (own echo). */
+	virtual void flushRx() = 0;
+	/** Monotonic time in microseconds. */
+	virtual uint32_t timestamp() = 0;
+};
@@ -0,0 +1,190 @@
+/*
+window-aggregator.cpp - Estia R32 heat pump sensors and status data aggregation
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "window-aggregator.hpp"
+
+static size_t putUint16(uint8_t* out, uint16_t value) {
+	out[0] = value >> 8;
+	out[1] = value & 0xff;
+	return 2;
+}
+
+static size_t putUint32(uint8_t* out, uint32_t value) {
+	putUint16(out, value >> 16);
+	putUint16(out + 2, value & 0xffff);
+	return 4;
+}
+
+float SensorAggregate::mean() const {
+	return count == 0 ? 0 : static_cast<float>(sum) / count;
+}
+
+/** @return on-time in permille of window time covered by status data, `0xffff` no status data */
+uint16_t WindowRecord::dutyCycle(DutyFlag flag) const {
+	if (statusTime == 0) { return 0xffff; }
+
+	return static_cast<uint64_t>(onTime[flag]) * 1000 / statusTime;
+}
+
+// sensors with samples in window
+uint8_t WindowRecord::sensorsCount() const {
+	uint8_t count = 0;
+	for (const SensorAggregate& sensor : sensors) {
+		if (sensor.count != 0) { count++; }
+	}
+	return count;
+}
+
+size_t WindowRecord::packedSize() const {
+	return WINDOW_PACKED_HEADER_LEN + sensorsCount() * WINDOW_PACKED_SENSOR_LEN + duty_count * WINDOW_PACKED_DUTY_LEN;
+}
+
+/** Write window as compact big endian record.
+*
+* `start` `length` (uint32 ms), sensors count, duty flags count,
+* for every sensor with samples: code, count (uint16), min, max, last (int16), mean x10 (int32),
+* for every duty flag: permille (uint16, `0xffff` no status data).
+* @return written length, `0` when `outSize` is too small
+*/
+size_t WindowRecord::pack(uint8_t* out, size_t outSize) const {
+	if (outSize < packedSize()) { return 0; }
+
+	size_t len = 0;
+	len += putUint32(out + len, start);
+	len += putUint32(out + len, length);
+	out[len++] = sensorsCount();
+	out[len++] = duty_count;
+	for (const SensorAggregate& sensor : sensors) {
+		if (sensor.count == 0) { continue; }
+		out[len++] = sensor.code;
+		len += putUint16(out + len, sensor.count);
+		len += putUint16(out + len, sensor.min);
+		len += putUint16(out + len, sensor.max);
+		len += putUint16(out + len, sensor.last);
+		len += putUint32(out + len, static_cast<int64_t>(sensor.sum) * 10 / sensor.count);    // full int16 range x10
+	}
+	for (uint8_t flag = 0; flag < duty_count; flag++) {
+		len += putUint16(out + len, dutyCycle(static_cast<DutyFlag>(flag)));
+	}
+	return len;
+}
+
+WindowAggregator::WindowAggregator()
+    : window()
+    , handler(nullptr)
+    , flags()
+    , statusKnown(false)
+    , lastStatusTime(0) {
+}
+
+/**
+* @param length window length (ms), `0` disables aggregation
+* @param now first window start
+*/
+void WindowAggregator::begin(uint32_t length, uint32_t now) {
+	window.length = length;
+	statusKnown = false;
+	reset(now);
+}
+
+void WindowAggregator::onWindow(WindowHandler handler) {
+	this->handler = handler;
+}
+
+/** @param value raw value, error codes must not be passed */
+void WindowAggregator::sample(uint8_t code, int16_t value, uint32_t now) {
+	if (!enabled()) { return; }
+	uint8_t idx = SensorStore::index(code);
+	if (idx == SENSOR_NONE) { return; }
+
+	tick(now);
+	SensorAggregate& sensor = window.sensors[idx];
+	if (sensor.count == 0) {
+		sensor.min = value;
+		sensor.max = value;
+		sensor.sum = 0;
+	}
+	if (value < sensor.min) { sensor.min = value; }
+	if (value > sensor.max) { sensor.max = value; }
+	if (sensor.count < UINT16_MAX) {
+		sensor.sum += value;
+		sensor.count++;
+	}
+	sensor.last = value;
+}
+
+// flags state holds from this status frame until next one
+void WindowAggregator::status(const StatusData& data, uint32_t now) {
+	if (!enabled()) { return; }
+
+	tick(now);
+	accrue(now);
+	flags[WindowRecord::duty_cooling_cmp] = data.coolingCMP;
+	flags[WindowRecord::duty_heating_cmp] = data.heatingCMP;
+	flags[WindowRecord::duty_hot_water_cmp] = data.hotWaterCMP;
+	flags[WindowRecord::duty_hot_water_heater] = data.hotWaterHeater;
+	flags[WindowRecord::duty_backup_heater] = data.backupHeater;
+	flags[WindowRecord::duty_pump1] = data.pump1;
+	flags[WindowRecord::duty_defrost] = data.defrostInProgress;
+	statusKnown = true;
+}
+
+// close elapsed windows
+void WindowAggregator::tick(uint32_t now) {
+	if (!enabled()) { return; }
+
+	while (now - window.start >= window.length) {
+		uint32_t end = window.start + window.length;
+		accrue(end);
+		if (handler) { handler(window); }
+		reset(end);
+	}
+}
+
+bool WindowAggregator::enabled() const {
+	return window.length != 0;
+}
+
+// window in progress
+const WindowRecord& WindowAggregator::current() const {
+	return window;
+}
+
+void WindowAggregator::accrue(uint32_t until) {
+	if (statusKnown) {
+		uint32_t elapsed = until - lastStatusTime;
+		window.statusTime += elapsed;
+		for (uint8_t flag = 0; flag < WindowRecord::duty_count; flag++) {
+			if (flags[flag]) { window.onTime[flag] += elapsed; }
+		}
+	}
+	lastStatusTime = until;
+}
+
+void WindowAggregator::reset(uint32_t start) {
+	window.start = start;
+	window.statusTime = 0;
+	for (uint32_t& time : window.onTime) {
+		time = 0;
+	}
+	for (uint8_t idx = 0; idx < SENSORS_COUNT; idx++) {
+		window.sensors[idx].code = SensorStore::descriptor(idx).code;
+		window.sensors[idx].count = 0;
+	}
+	lastStatusTime = start;
+}
@@ -0,0 +1,99 @@
+/*
+window-aggregator.hpp - Estia R32 heat pump sensors and status data aggregation
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "frames/status-frames.hpp"
+#include "sensor-store.hpp"
+#include <functional>
+
+#define WINDOW_PACKED_HEADER_LEN 10    // start, length, sensors count, duty flags count
+#define WINDOW_PACKED_SENSOR_LEN 13    // code, count, min, max, last, mean x10 (int32)
+#define WINDOW_PACKED_DUTY_LEN 2       // permille
+
+/**
+* @param code data code
+* @param count samples in window, `0` no data
+* @param sum for mean
+*/
+struct SensorAggregate {
+	uint8_t code;
+	uint16_t count;
+	int16_t min;
+	int16_t max;
+	int16_t last;
+	int32_t sum;
+
+	float mean() const;
+};
+
+/** Single closed window, sensors indexed as in `SensorStore`. */
+struct WindowRecord {
+	enum DutyFlag : uint8_t {
+		duty_cooling_cmp,
+		duty_heating_cmp,
+		duty_hot_water_cmp,
+		duty_hot_water_heater,
+		duty_backup_heater,
+		duty_pump1,
+		duty_defrost,
+		duty_count,
+	};
+
+	uint32_t start;     // ms
+	uint32_t length;    // ms
+	uint32_t statusTime;    // ms of window covered by status data
+	uint32_t onTime[duty_count];    // ms
+	SensorAggregate sensors[SENSORS_COUNT];
+
+	uint16_t dutyCycle(DutyFlag flag) const;
+	uint8_t sensorsCount() const;
+	size_t packedSize() const;
+	size_t pack(uint8_t* out, size_t outSize) const;
+};
+
+using WindowHandler = std::function<void(const WindowRecord& window)>;
+
+/** Tumbling window aggregation of sensors values and status flags.
+*
+* Every sensor keeps running min/max/sum/count/last, status flags keep time weighted
+* on-time (state lasts until next status frame). Memory is one `WindowRecord`,
+* no matter how many samples arrive. Closed window is passed to handler and reset.
+*/
+class WindowAggregator {
+  private:
+	WindowRecord window;
+	WindowHandler handler;
+	bool flags[WindowRecord::duty_count];
+	bool statusKnown;
+	uint32_t lastStatusTime;
+
+	void accrue(uint32_t until);
+	void reset(uint32_t start);
+
+  public:
+	WindowAggregator();
+
+	void begin(uint32_t length, uint32_t now);
+	void onWindow(WindowHandler handler);
+	void sample(uint8_t code, int16_t value, uint32_t now);
+	void status(const StatusData& data, uint32_t now);
+	void tick(uint32_t now);
+	bool enabled() const;
+	const WindowRecord& current() const;
+};
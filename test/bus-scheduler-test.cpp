@@ -0,0 +1,150 @@
+/*
+bus-scheduler-test.cpp - transmit scheduler collisions and learned cadence
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "bus-scheduler.hpp"
+#include "estia-serial.hpp"
+#include "test.hpp"
+
+#define CHAR_TIME ESTIA_SERIAL_CHAR_TIME
+#define COMMAND_LEN 17    // mode change command
+
+// own frame received back is not a collision, other frame overlapping it is
+static void echoTest() {
+	BusScheduler scheduler;
+	uint32_t txStart = 1000000;
+	scheduler.transmitted(txStart, COMMAND_LEN);
+	// receive time is estimated, echo may appear up to a character earlier or later
+	scheduler.frameReceived(FrameClassifier::frame_unknown, txStart + (COMMAND_LEN - 1) * CHAR_TIME, COMMAND_LEN, true);
+	CHECK_EQ(scheduler.getCollisions(), 0);
+	scheduler.frameReceived(FrameClassifier::frame_ack, txStart + (COMMAND_LEN + FRAME_ACK_LEN + 5) * CHAR_TIME, FRAME_ACK_LEN, true);
+	CHECK_EQ(scheduler.getCollisions(), 0);
+
+	txStart += 1000000;
+	scheduler.transmitted(txStart, FRAME_REQ_DATA_LEN);
+	scheduler.frameReceived(FrameClassifier::frame_heartbeat, txStart + 10 * CHAR_TIME, FRAME_HEARTBEAT_LEN, true);
+	CHECK_EQ(scheduler.getCollisions(), 1);
+}
+
+#define SIM_PERIOD 1000000            // us, heartbeat period
+#define SIM_FRAME_GAP 16000           // us, master gap between burst frames (longer than guard time)
+#define SIM_TURNAROUND 15000          // us, master response delay
+#define SIM_LOST_HEARTBEAT 3          // every n-th heartbeat is received with bad CRC
+#define SIM_REQUESTS 300
+#define SIM_LEARN_TIME (5 * SIM_PERIOD)
+
+struct SimFrame {
+	FrameClassifier::FrameKind kind;
+	uint32_t start;
+	uint8_t length;
+	bool master;
+	bool corrupted;
+
+	uint32_t end() const { return start + BusScheduler::airtime(length); }
+};
+
+struct SimResult {
+	uint32_t attempts;
+	uint32_t collisions;
+	uint32_t schedulerCollisions;
+};
+
+/** Master cycle: heartbeat, status and status update sent back to back with short gaps. */
+static void masterCycle(std::vector<SimFrame>& frames, uint32_t cycle) {
+	uint32_t start = SIM_PERIOD + cycle * SIM_PERIOD + (cycle * 7919) % 4000;    // 0-4 ms jitter
+	SimFrame heartbeat = {FrameClassifier::frame_heartbeat, start, FRAME_HEARTBEAT_LEN, true, cycle % SIM_LOST_HEARTBEAT == 0};
+	SimFrame status = {FrameClassifier::frame_status, heartbeat.end() + SIM_FRAME_GAP, FRAME_STATUS_LEN, true, false};
+	SimFrame update = {FrameClassifier::frame_status_update, status.end() + SIM_FRAME_GAP, FRAME_UPDATE_LEN, true, false};
+	frames.push_back(heartbeat);
+	frames.push_back(status);
+	frames.push_back(update);
+}
+
+static bool overlaps(const SimFrame& frame, uint32_t start, uint32_t end) {
+	return static_cast<int32_t>(frame.end() - start) > 0 && static_cast<int32_t>(end - frame.start) > 0;
+}
+
+/** Data requests against simulated master, 1 ms steps.
+*
+* @param useScheduler `false` send on line silence only (guard time)
+*/
+static SimResult simulate(bool useScheduler) {
+	BusScheduler scheduler;
+	std::vector<SimFrame> frames;    // sorted by start
+	uint32_t cycles = 0;
+	uint32_t lineFree = 0;           // end of last frame on the line
+	uint32_t nextRequest = SIM_LEARN_TIME;
+	size_t delivered = 0;
+	SimResult result = {0, 0, 0};
+
+	for (uint32_t now = 0; result.attempts - result.collisions < SIM_REQUESTS; now += 1000) {
+		while (frames.empty() || frames.back().start < now + SIM_PERIOD) { masterCycle(frames, cycles++); }
+		// frames completed by now reach sniffer
+		for (; delivered < frames.size() && static_cast<int32_t>(now - frames[delivered].end()) >= 0; delivered++) {
+			const SimFrame& frame = frames[delivered];
+			scheduler.frameReceived(frame.kind, frame.end(), frame.length, !frame.corrupted);
+			if (static_cast<int32_t>(frame.end() - lineFree) > 0) { lineFree = frame.end(); }
+		}
+		bool busy = delivered < frames.size() && static_cast<int32_t>(now - frames[delivered].start) >= 0;
+		uint32_t idle = busy || static_cast<int32_t>(now - lineFree) < 0 ? 0 : now - lineFree;
+		if (static_cast<int32_t>(now - nextRequest) < 0) { continue; }
+		bool clear = useScheduler ? scheduler.clearToSend(now, idle, FRAME_REQ_DATA_LEN, FRAME_RES_DATA_LEN) : idle >= BUS_GUARD_TIME;
+		if (!clear) { continue; }
+
+		// request, echo not received (RX disabled), master answers after turnaround
+		result.attempts++;
+		scheduler.transmitted(now, FRAME_REQ_DATA_LEN);
+		SimFrame request = {FrameClassifier::frame_data_request, now, FRAME_REQ_DATA_LEN, false, false};
+		SimFrame response = {FrameClassifier::frame_data_response, request.end() + SIM_TURNAROUND, FRAME_RES_DATA_LEN, true, false};
+		bool collision = false;
+		for (size_t idx = delivered; idx < frames.size(); idx++) {
+			if (!frames[idx].master || !overlaps(frames[idx], request.start, response.end())) { continue; }
+			frames[idx].corrupted = true;
+			collision = true;
+		}
+		if (collision) {
+			result.collisions++;
+			nextRequest = now + REQUEST_TIMEOUT * 1000;
+			continue;
+		}
+		// own frames are on the line, response is delivered in start order
+		lineFree = request.end();
+		size_t pos = delivered;
+		while (pos < frames.size() && static_cast<int32_t>(frames[pos].start - response.start) < 0) { pos++; }
+		frames.insert(frames.begin() + pos, response);
+		nextRequest = response.end() + REQUEST_DELAY * 1000 + (result.attempts * 7919) % 50000;    // 0-50 ms sensor handling
+	}
+	result.schedulerCollisions = scheduler.getCollisions();
+	return result;
+}
+
+// learned cadence avoids master bursts, also when heartbeat is lost
+static void simulationTest() {
+	SimResult naive = simulate(false);
+	SimResult scheduled = simulate(true);
+	printf("%u requests: line silence only %u/%u attempts collided, scheduler %u/%u\n", SIM_REQUESTS, naive.collisions, naive.attempts, scheduled.collisions, scheduled.attempts);
+	CHECK(naive.collisions > SIM_REQUESTS / 10);
+	CHECK_EQ(scheduled.collisions, 0);
+	CHECK_EQ(scheduled.schedulerCollisions, scheduled.collisions);
+}
+
+int main() {
+	echoTest();
+	simulationTest();
+	return testResult("bus-scheduler-test");
+}
@@ -0,0 +1,72 @@
+/*
+captured-frames.hpp - frames captured on the bus (frames.md)
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#define CAPTURED_HEARTBEAT "a0 00 10 07 00 08 00 00 fe 00 8a 75 05"
+#define CAPTURED_STATUS_SHORT "a0 00 58 0b 00 08 00 00 fe 00 2b 00 00 01 32 7c 58"
+#define CAPTURED_REQUEST "a0 00 17 0f 00 00 40 08 00 00 80 00 ef 00 2c 08 00 06 00 2c 40"
+#define CAPTURED_RESPONSE "a0 00 1a 0d 00 08 00 00 40 00 ef 00 80 00 2c 00 1f 73 83"
+#define CAPTURED_ACK "a0 00 18 09 00 08 00 08 00 00 a1 00 41 c1 95"
+
+/** Long status frames (31 bytes) and TWO/TWI at bytes 26/27 (`value / 2 - 16`). */
+struct CapturedStatus {
+	const char* frame;
+	int8_t two;
+	int8_t twi;
+};
+
+static const CapturedStatus capturedStatus[] = {
+    {"a0 00 58 19 00 08 00 00 fe 03 c6 c1 30 10 78 5c 7a 78 5c 7a 00 00 00 00 00 e9 89 5e 00 41 4a", 52, 31},
+    {"a0 00 58 19 00 08 00 00 fe 03 c6 c1 30 12 78 62 7a 78 5e 6c 00 10 00 00 00 e9 84 5d 00 d8 d0", 50, 30},
+    {"a0 00 58 19 00 08 00 00 fe 03 c6 c2 24 18 78 60 7a 78 5e 55 00 10 00 00 00 e9 58 68 00 f1 4b", 28, 36},
+    {"a0 00 58 19 00 08 00 00 fe 03 c6 c1 00 10 76 5c 7a 76 5c 7a 00 00 00 00 00 e9 7d 5a 00 34 e2", 46, 29},
+    {"a0 00 58 19 00 08 00 00 fe 03 c6 c0 20 00 76 5a 7a 76 50 70 00 10 00 00 00 e9 5d 58 00 ca 49", 30, 28},
+    {"a0 00 58 19 00 08 00 00 fe 03 c6 c0 00 00 76 5a 7a 76 5a 7a 00 00 00 00 00 e9 5d 58 00 a6 1c", 30, 28},
+    {"a0 00 58 19 00 08 00 00 fe 03 c6 a1 10 10 76 48 48 76 48 48 00 00 00 00 00 e9 7f 4e 00 94 b7", 47, 23},
+};
+
+/** Status update frames (21 bytes), no TWO/TWI. */
+static const char* const capturedUpdates[] = {
+    "a0 00 1c 0f 00 08 00 00 fe 03 c6 c1 00 12 76 60 7a 00 00 15 4c",
+    "a0 00 1c 0f 00 08 00 00 fe 03 c6 c0 20 00 76 5a 7a 10 00 b8 5b",
+    "a0 00 1c 0f 00 08 00 00 fe 03 c6 a1 10 00 76 48 48 00 00 60 ff",
+};
+
+/** Commands sent by remote controller. */
+static const char* const capturedCommands[] = {
+    "a0 00 11 08 00 00 40 08 00 03 c0 06 83 e7",
+    "a0 00 11 08 00 00 40 08 00 00 41 23 8f 38",
+    "a0 00 11 0b 00 00 40 08 00 03 c4 88 08 00 00 cc 10",
+    "a0 00 11 0a 00 00 40 08 00 00 15 00 46 01 e7 25",
+    "a0 00 11 0c 00 00 40 08 00 03 c1 02 5c 7a 76 5c b2 d1",
+    "a0 00 11 07 00 00 40 08 00 00 2b 15 f6",
+};
+
+/** Every captured frame above, in order. */
+inline std::vector<const char*> capturedFrames() {
+	std::vector<const char*> frames = {CAPTURED_HEARTBEAT, CAPTURED_STATUS_SHORT, CAPTURED_REQUEST, CAPTURED_RESPONSE, CAPTURED_ACK};
+	for (const CapturedStatus& status : capturedStatus) { frames.push_back(status.frame); }
+	for (const char* frame : capturedUpdates) { frames.push_back(frame); }
+	for (const char* frame : capturedCommands) { frames.push_back(frame); }
+	return frames;
+}
@@ -0,0 +1,128 @@
+/*
+command-queue-test.cpp - commands coalescing, priorities and drops
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "command-queue.hpp"
+#include "test.hpp"
+#include <vector>
+
+static bool sameFrame(const CommandQueue::Command& command, const EstiaFrame& frame) {
+	return command.frame.size() == frame.size() && std::equal(command.frame.begin(), command.frame.end(), frame.data());
+}
+
+// repeated setpoint changes for one zone become single command with newest value
+static void coalesceTest() {
+	CommandQueue queue;
+	for (uint8_t temperature = 20; temperature < 30; temperature++) {
+		CHECK(queue.push(TemperatureFrame(TEMPERATURE_HEATING_CODE, temperature, temperature, 45)));
+	}
+	CHECK_EQ(queue.size(), 1);
+	CHECK_EQ(queue.getReplaced(), 9);
+	CHECK_EQ(queue.getDrops(), 0);
+	CHECK(sameFrame(queue.front(), TemperatureFrame(TEMPERATURE_HEATING_CODE, 29, 29, 45)));
+
+	// other zone is separate command
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HOT_WATER_CODE, 0, 0, 50)));
+	CHECK_EQ(queue.size(), 2);
+}
+
+// off command jumps pending setpoints, locked front stays first
+static void priorityTest() {
+	SwitchFrame off(SWITCH_OPERATION_COOL_HEAT, 0);
+	CommandQueue queue;
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HEATING_CODE, 25, 25, 45)));
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HOT_WATER_CODE, 0, 0, 50)));
+	CHECK(queue.push(off));
+	CHECK(sameFrame(queue.front(), off));
+	CHECK_EQ(queue.front().priority, CommandQueue::priority_high);
+
+	queue = CommandQueue();
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HEATING_CODE, 25, 25, 45)));
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HOT_WATER_CODE, 0, 0, 50)));
+	queue.lockFront();
+	CHECK(queue.push(off));
+	CHECK(sameFrame(queue.front(), TemperatureFrame(TEMPERATURE_HEATING_CODE, 25, 25, 45)));
+	CHECK_EQ(queue.size(), 3);
+
+	// locked front is not replaced by command of the same kind
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HEATING_CODE, 26, 26, 45)));
+	CHECK(sameFrame(queue.front(), TemperatureFrame(TEMPERATURE_HEATING_CODE, 25, 25, 45)));
+	CHECK_EQ(queue.size(), 4);
+
+	queue.pop();
+	CHECK(sameFrame(queue.front(), off));
+	queue.pop();
+	CHECK(sameFrame(queue.front(), TemperatureFrame(TEMPERATURE_HOT_WATER_CODE, 0, 0, 50)));
+	queue.pop();
+	CHECK(sameFrame(queue.front(), TemperatureFrame(TEMPERATURE_HEATING_CODE, 26, 26, 45)));
+}
+
+// full queue evicts newest lower priority command or rejects new one
+static void fullQueueTest() {
+	std::vector<std::pair<uint16_t, CommandQueue::DropReason>> dropped;
+	CommandQueue queue;
+	queue.onDrop([&dropped](uint16_t dataType, CommandQueue::DropReason reason) { dropped.push_back({dataType, reason}); });
+
+	// every command kind once, front locked so its kind can be queued again
+	SwitchFrame off(SWITCH_OPERATION_COOL_HEAT, 0);
+	CHECK(queue.push(off));
+	queue.lockFront();
+	CHECK(queue.push(SwitchFrame(SWITCH_OPERATION_HOT_WATER, 1)));
+	CHECK(queue.push(SetModeFrame(SET_AUTO_MODE_CODE, 1)));
+	CHECK(queue.push(SetModeFrame(SET_QUIET_MODE_CODE, 1)));
+	CHECK(queue.push(SetModeFrame(SET_NIGHT_MODE_CODE, 1)));
+	CHECK(queue.push(OperationMode(OPERATION_MODE_HEATING)));
+	CHECK(queue.push(ForcedDefrostFrame(0), CommandQueue::priority_normal));
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_COOLING_CODE, 20, 20, 45)));
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HEATING_CODE, 25, 25, 45)));
+	CHECK(queue.push(TemperatureFrame(TEMPERATURE_HOT_WATER_CODE, 0, 0, 50)));
+	CHECK_EQ(queue.size(), CMD_QUEUE_SIZE);
+	CHECK(dropped.empty());
+
+	// nothing with lower priority to evict
+	CHECK(!queue.push(off, CommandQueue::priority_low));
+	CHECK_EQ(dropped.size(), 1);
+	CHECK_EQ(dropped.back().first, FRAME_DATA_TYPE_OPERATION_SWITCH);
+	CHECK_EQ(dropped.back().second, CommandQueue::drop_queue_full);
+	CHECK_EQ(queue.size(), CMD_QUEUE_SIZE);
+
+	// newest low priority setpoint makes room for off command
+	CHECK(queue.push(off));
+	CHECK_EQ(dropped.size(), 2);
+	CHECK_EQ(dropped.back().first, FRAME_DATA_TYPE_TEMPERATURE_CHANGE);
+	CHECK_EQ(dropped.back().second, CommandQueue::drop_evicted);
+	CHECK_EQ(queue.getDrops(), 2);
+	CHECK_EQ(queue.size(), CMD_QUEUE_SIZE);
+
+	queue.pop();
+	CHECK(sameFrame(queue.front(), off));
+	for (size_t idx = queue.size(); idx > 1; idx--) { queue.pop(); }
+	CHECK(sameFrame(queue.front(), TemperatureFrame(TEMPERATURE_HEATING_CODE, 25, 25, 45)));
+
+	queue.lockFront();
+	queue.dropFront();
+	CHECK(queue.empty());
+	CHECK_EQ(dropped.back().second, CommandQueue::drop_no_ack);
+}
+
+int main() {
+	coalesceTest();
+	priorityTest();
+	fullQueueTest();
+	return testResult("command-queue-test");
+}
@@ -0,0 +1,64 @@
+/*
+crc16-test.cpp - table driven CRC against bitwise reference
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "frames/frame.hpp"
+#include "test.hpp"
+#include <stdlib.h>
+
+// table, bitwise reference and constexpr variant agree with CRC in captured frames
+static void referenceTest() {
+	for (const char* captured : capturedFrames()) {
+		std::vector<uint8_t> frame = hexFrame(captured);
+		size_t len = frame.size() - 2;
+		uint16_t expected = frame[len] << 8 | frame[len + 1];    // big endian
+		CHECK_EQ(EstiaFrame::crc16(frame.data(), len), expected);
+		CHECK_EQ(Crc16::calculate(frame.data(), len), expected);
+		CHECK_EQ(Crc16::compute(frame.data(), len), expected);
+	}
+}
+
+// update/finalize over random chunks (single bytes and spans) matches calculate()
+static void chunksTest() {
+	srand(1);
+	for (const char* captured : capturedFrames()) {
+		std::vector<uint8_t> frame = hexFrame(captured);
+		size_t len = frame.size() - 2;
+		for (int run = 0; run < 100; run++) {
+			uint16_t crc = Crc16::init();
+			for (size_t pos = 0; pos < len;) {
+				size_t chunk = rand() % 8;
+				if (chunk > len - pos) { chunk = len - pos; }
+				if (chunk == 1 && run % 2) {
+					crc = Crc16::update(crc, frame[pos]);
+				} else {
+					crc = Crc16::update(crc, frame.data() + pos, chunk);    // empty chunk keeps CRC
+				}
+				pos += chunk;
+			}
+			CHECK_EQ(Crc16::finalize(crc), Crc16::calculate(frame.data(), len));
+		}
+	}
+}
+
+int main() {
+	referenceTest();
+	chunksTest();
+	return testResult("crc16-test");
+}
@@ -0,0 +1,120 @@
+/*
+frame-assembler-test.cpp - recorded byte streams fed in random chunks
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "frames/frame-assembler.hpp"
+#include "test.hpp"
+#include <stdlib.h>
+
+using Frames = std::vector<std::vector<uint8_t>>;
+
+/** Assembler output collected by handler, pool is only a queue here. */
+class Collector {
+  public:
+	FramePool pool;
+	FrameAssembler assembler;
+	Frames frames;
+	std::vector<FrameView::CrcState> states;
+
+	Collector() {
+		pool.allocate(4);
+		assembler.onFrame([this](FrameBuffer& frame, FrameView::CrcState crc) {
+			frames.emplace_back(frame.begin(), frame.end());
+			states.push_back(crc);
+		});
+	}
+};
+
+static Frames capturedStream(std::vector<uint8_t>& stream) {
+	Frames frames;
+	for (const char* frame : capturedFrames()) { frames.push_back(hexFrame(frame)); }
+	for (auto& frame : frames) { stream.insert(stream.end(), frame.begin(), frame.end()); }
+	return frames;
+}
+
+// frames are byte identical whatever chunks bytes arrive in
+static void randomChunksTest() {
+	std::vector<uint8_t> stream;
+	Frames expected = capturedStream(stream);
+	srand(8);
+	for (int run = 0; run < 200; run++) {
+		Collector collector;
+		size_t queued = 0;
+		for (size_t pos = 0; pos < stream.size();) {
+			size_t len = 1 + rand() % (run % 2 ? 4 : 48);
+			if (len > stream.size() - pos) { len = stream.size() - pos; }
+			queued += collector.assembler.push(stream.data() + pos, len, collector.pool);
+			pos += len;
+		}
+		CHECK(collector.frames == expected);
+		CHECK_EQ(queued, expected.size());
+		CHECK(!collector.assembler.busy());
+		for (FrameView::CrcState state : collector.states) { CHECK_EQ(state, FrameView::crc_valid); }
+	}
+}
+
+// `a0 00` in frame data does not start new frame, length is followed
+static void frameBeginInDataTest() {
+	std::vector<uint8_t> frame = hexFrame("a0 00 11 0c 00 00 40 08 00 03 c1 08 a0 00 78 5c 00 00");
+	uint16_t crc = Crc16::calculate(frame.data(), frame.size() - 2);
+	frame[frame.size() - 2] = crc >> 8;
+	frame[frame.size() - 1] = crc & 0xff;
+	Collector collector;
+	for (uint8_t byte : frame) { collector.assembler.push(byte, collector.pool); }
+	CHECK_EQ(collector.frames.size(), 1);
+	CHECK(collector.frames.size() == 1 && collector.frames[0] == frame);
+	CHECK(collector.states.size() == 1 && collector.states[0] == FrameView::crc_valid);
+}
+
+// bytes before frame begin are passed on as one malformed frame (frame fixer input)
+static void garbageTest() {
+	std::vector<uint8_t> ack = hexFrame(CAPTURED_ACK);
+	std::vector<uint8_t> stream = {0x12, 0x34, 0x56};
+	stream.insert(stream.end(), ack.begin(), ack.end());
+	Collector collector;
+	collector.assembler.push(stream.data(), stream.size(), collector.pool);
+	CHECK_EQ(collector.frames.size(), 2);
+	if (collector.frames.size() != 2) { return; }
+	CHECK(collector.frames[0] == std::vector<uint8_t>({0x12, 0x34, 0x56}));
+	CHECK_EQ(collector.states[0], FrameView::crc_unchecked);
+	CHECK(collector.frames[1] == ack);
+}
+
+// frame with lost bytes swallows start of next frame, both are split at next frame begin
+static void joinedFramesTest() {
+	std::vector<uint8_t> ack = hexFrame(CAPTURED_ACK);
+	std::vector<uint8_t> status = hexFrame(capturedStatus[0].frame);
+	std::vector<uint8_t> stream(ack.begin(), ack.end() - 3);
+	stream.insert(stream.end(), status.begin(), status.end());
+	Collector collector;
+	collector.assembler.push(stream.data(), stream.size(), collector.pool);
+	CHECK_EQ(collector.frames.size(), 2);
+	if (collector.frames.size() != 2) { return; }
+	CHECK(collector.frames[0] == std::vector<uint8_t>(ack.begin(), ack.end() - 3));
+	CHECK(collector.frames[1] == status);
+	CHECK_EQ(collector.states[1], FrameView::crc_valid);
+}
+
+int main() {
+	randomChunksTest();
+	frameBeginInDataTest();
+	garbageTest();
+	joinedFramesTest();
+	return testResult("frame-assembler-test");
+}
@@ -0,0 +1,85 @@
+/*
+frame-pool-test.cpp - sniffed frames pool and decoding independent of free slots
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "estia-serial.hpp"
+#include "test.hpp"
+
+static const char* ackFrame = "a0 00 18 09 00 08 00 08 00 00 a1 00 41 c1 95";
+static const char* statusFrame = "a0 00 58 19 00 08 00 00 fe 03 c6 c1 30 10 78 5c 7a 78 5c 7a 00 00 00 00 00 e9 89 5e 00 41 4a";
+
+// every assembled frame reaches handler, queue stores what fits
+static void assemblerTest() {
+	FramePool pool;
+	CHECK(pool.allocate(2));
+	FrameHandle first, second;
+	FrameAssembler assembler;
+	size_t handled = 0;
+	assembler.onFrame([&](FrameBuffer&, FrameView::CrcState) { handled++; });
+
+	std::vector<uint8_t> ack = hexFrame(ackFrame);
+	CHECK_EQ(assembler.push(ack.data(), ack.size(), pool), 1);
+	CHECK_EQ(assembler.push(ack.data(), ack.size(), pool), 1);
+	first = pool.take();
+	second = pool.take();
+	CHECK(first && second);
+
+	// all slots held by app, frames are dropped but still handled
+	std::vector<uint8_t> frames;
+	for (int idx = 0; idx < 3; idx++) { frames.insert(frames.end(), ack.begin(), ack.end()); }
+	CHECK_EQ(assembler.push(frames.data(), frames.size(), pool), 0);
+	CHECK_EQ(handled, 5);
+	CHECK_EQ(pool.size(), 0);
+	CHECK_EQ(pool.drops(), 3);
+
+	// slot released, 3 frames completed at once, oldest overwritten
+	first.release();
+	CHECK_EQ(assembler.push(frames.data(), frames.size(), pool), 3);
+	CHECK_EQ(handled, 8);
+	CHECK_EQ(pool.size(), 1);
+}
+
+// app holding every frame slot does not stop status decoding
+static void heldSlotsTest() {
+	MemoryTransport transport;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+
+	std::vector<FrameHandle> held;
+	std::vector<uint8_t> ack = hexFrame(ackFrame);
+	for (int idx = 0; idx < SNIFFED_FRAMES_LIMIT; idx++) {
+		transport.receive(ack);
+		estiaSerial.sniffer();
+		held.push_back(estiaSerial.getSniffedFrame());
+		CHECK(held.back().valid());
+	}
+	CHECK_EQ(estiaSerial.getAck(), 0x0041);
+
+	transport.receive(hexFrame(statusFrame));
+	estiaSerial.sniffer();
+	CHECK(estiaSerial.newStatusData);
+	CHECK_EQ(estiaSerial.getStatusData().waterInletTemperature, 31);
+	CHECK_EQ(estiaSerial.getFrameDrops(), 1);
+	CHECK(!estiaSerial.getSniffedFrame().valid());
+}
+
+int main() {
+	assemblerTest();
+	heldSlotsTest();
+	return testResult("frame-pool-test");
+}
@@ -0,0 +1,168 @@
+/*
+idle-gap-test.cpp - frame boundaries from synthetic byte timestamps
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "estia-serial.hpp"
+#include "test.hpp"
+
+#define CHAR_TIME ESTIA_SERIAL_CHAR_TIME
+#define IDLE_GAP static_cast<uint32_t>(ESTIA_SERIAL_IDLE_GAP * CHAR_TIME)
+
+class Collector {
+  public:
+	FramePool pool;
+	FrameAssembler assembler;
+	std::vector<std::vector<uint8_t>> frames;
+
+	Collector() {
+		pool.allocate(4);
+		assembler.setIdleGap(IDLE_GAP);
+		assembler.onFrame([this](FrameBuffer& frame, FrameView::CrcState) { frames.emplace_back(frame.begin(), frame.end()); });
+	}
+
+	/** Bytes sent back to back, one character time apart. @return time after last byte */
+	uint32_t send(const std::vector<uint8_t>& bytes, size_t len, uint32_t time) {
+		for (size_t idx = 0; idx < len; idx++, time += CHAR_TIME) { assembler.push(bytes[idx], time, pool); }
+		return time;
+	}
+};
+
+// frame missing its end is closed by line silence, next frame is not joined to it
+static void gapSplitsFramesTest() {
+	std::vector<uint8_t> ack = hexFrame(CAPTURED_ACK);
+	std::vector<uint8_t> status = hexFrame(capturedStatus[0].frame);
+	Collector collector;
+	uint32_t time = collector.send(ack, ack.size() - 3, 1000);
+	CHECK(collector.frames.empty());
+	uint32_t lastByte = time - CHAR_TIME;
+	collector.send(status, status.size(), lastByte + IDLE_GAP + 1);
+	CHECK_EQ(collector.frames.size(), 2);
+	if (collector.frames.size() != 2) { return; }
+	CHECK(collector.frames[0] == std::vector<uint8_t>(ack.begin(), ack.end() - 3));
+	CHECK(collector.frames[1] == status);
+	CHECK_EQ(collector.assembler.getFrameEndTime(), lastByte + IDLE_GAP + 1 + (status.size() - 1) * CHAR_TIME);
+}
+
+// inter-byte jitter shorter than gap keeps frame together
+static void jitterTest() {
+	std::vector<uint8_t> status = hexFrame(capturedStatus[1].frame);
+	Collector collector;
+	uint32_t time = 0xfffff000;    // timer wraps inside frame
+	for (uint8_t byte : status) {
+		collector.assembler.push(byte, time, collector.pool);
+		time += IDLE_GAP;
+	}
+	CHECK_EQ(collector.frames.size(), 1);
+	CHECK(collector.frames.size() == 1 && collector.frames[0] == status);
+}
+
+// idle line closes incomplete frame only after idle gap
+static void idleTest() {
+	std::vector<uint8_t> status = hexFrame(capturedStatus[2].frame);
+	Collector collector;
+	collector.send(status, 10, 0);
+	CHECK_EQ(collector.assembler.idle(IDLE_GAP, collector.pool), 0);
+	CHECK(collector.assembler.busy());
+	CHECK_EQ(collector.assembler.idle(IDLE_GAP + 1, collector.pool), 1);
+	CHECK(!collector.assembler.busy());
+	CHECK(collector.frames.size() == 1 && collector.frames[0].size() == 10);
+}
+
+// EstiaSerial timestamps bytes from transport time, frame closed a few ms after last byte
+static void snifferTest() {
+	MemoryTransport transport;
+	transport.now = 5000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	std::vector<std::vector<uint8_t>> frames;
+	estiaSerial.onRawFrame([&](const FrameView& frame) { frames.emplace_back(frame.begin(), frame.end()); });
+
+	// first bytes after begin() split over two reads
+	std::vector<uint8_t> ack = hexFrame(CAPTURED_ACK);
+	transport.receive(std::vector<uint8_t>(ack.begin(), ack.begin() + 5));
+	transport.now += 5 * CHAR_TIME;
+	estiaSerial.sniffer();
+	transport.receive(std::vector<uint8_t>(ack.begin() + 5, ack.end()));
+	transport.now += (ack.size() - 5) * CHAR_TIME;
+	estiaSerial.sniffer();
+	CHECK_EQ(frames.size(), 1);
+	CHECK(frames.size() == 1 && frames[0] == ack);
+	frames.clear();
+	transport.now += 100000;
+	estiaSerial.sniffer();
+
+	std::vector<uint8_t> status = hexFrame(capturedStatus[3].frame);
+	transport.receive(std::vector<uint8_t>(status.begin(), status.begin() + 20));
+	transport.now += 20 * CHAR_TIME;
+	estiaSerial.sniffer();
+	transport.now += IDLE_GAP / 2;
+	estiaSerial.sniffer();
+	CHECK(frames.empty());    // still inside frame
+	transport.now += IDLE_GAP;
+	estiaSerial.sniffer();
+	CHECK_EQ(frames.size(), 1);
+	CHECK(frames.size() == 1 && frames[0].size() == 20);
+
+	// complete frame is delivered on the read that completes it, without waiting for gap
+	transport.receive(status);
+	transport.now += status.size() * CHAR_TIME;
+	estiaSerial.sniffer();
+	CHECK_EQ(frames.size(), 2);
+	CHECK(frames.size() == 2 && frames[1] == status);
+}
+
+// main loop stall at frame start, bytes read in two chunks are one frame
+static void stallTest() {
+	MemoryTransport transport;
+	transport.now = 5000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	std::vector<std::vector<uint8_t>> frames;
+	estiaSerial.onRawFrame([&](const FrameView& frame) { frames.emplace_back(frame.begin(), frame.end()); });
+	estiaSerial.sniffer();
+
+	std::vector<uint8_t> status = hexFrame(capturedStatus[0].frame);
+	transport.now += 100000;    // 10 bytes arrived at end of stall
+	transport.receive(std::vector<uint8_t>(status.begin(), status.begin() + 10));
+	estiaSerial.sniffer();
+	transport.now += 5000;
+	transport.receive(std::vector<uint8_t>(status.begin() + 10, status.end()));
+	estiaSerial.sniffer();
+	CHECK_EQ(frames.size(), 1);
+	CHECK(frames.size() == 1 && frames[0] == status);
+
+	// stall with frame tail and next frame in one chunk, split by length
+	frames.clear();
+	transport.now += 100000;
+	std::vector<uint8_t> ack = hexFrame(CAPTURED_ACK);
+	transport.receive(status);
+	transport.receive(ack);
+	estiaSerial.sniffer();
+	CHECK_EQ(frames.size(), 2);
+	CHECK(frames.size() == 2 && frames[0] == status && frames[1] == ack);
+}
+
+int main() {
+	gapSplitsFramesTest();
+	jitterTest();
+	idleTest();
+	snifferTest();
+	stallTest();
+	return testResult("idle-gap-test");
+}
@@ -0,0 +1,209 @@
+/*
+linux-serial-transport-test.cpp - EstiaSerial end to end over pseudo terminal
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "estia-serial.hpp"
+#include "test.hpp"
+#include <atomic>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+
+// long status frame, TWO 52, TWI 31
+static const char* statusFrame = "a0 00 58 19 00 08 00 00 fe 03 c6 c1 30 10 78 5c 7a 78 5c 7a 00 00 00 00 00 e9 89 5e 00 41 4a";
+// TWI data response, value 31
+static const char* twiResponse = "a0 00 1a 0d 00 08 00 00 40 00 ef 00 80 00 2c 00 1f 73 83";
+
+/** Heat pump side of the pty pair. */
+class Bus {
+  public:
+	int fd;
+	std::vector<uint8_t> received;
+
+	Bus()
+	    : fd(posix_openpt(O_RDWR | O_NOCTTY)) {
+		grantpt(fd);
+		unlockpt(fd);
+		fcntl(fd, F_SETFL, O_NONBLOCK);
+	}
+	~Bus() { close(fd); }
+
+	const char* device() { return ptsname(fd); }
+	void send(const std::vector<uint8_t>& bytes, size_t from = 0, size_t len = SIZE_MAX) {
+		if (len > bytes.size() - from) { len = bytes.size() - from; }
+		CHECK_EQ(::write(fd, bytes.data() + from, len), len);
+	}
+	void receive() {
+		uint8_t buffer[64];
+		ssize_t count;
+		while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) { received.insert(received.end(), buffer, buffer + count); }
+	}
+};
+
+/** Run sniffer for `ms`, stop early when `done()` returns true. */
+template <typename Done>
+static void run(EstiaSerial& estiaSerial, LinuxSerialTransport& transport, Bus& bus, uint32_t ms, Done done) {
+	uint32_t start = millis();
+	while (millis() - start < ms && !done()) {
+		transport.waitAvailable(2);
+		if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }    // app reads sniffed frames
+		bus.receive();
+	}
+}
+
+/** Adapter echoes sent bytes, heat pump acks command and answers data request. */
+static void echoTest() {
+	Bus bus;
+	LinuxSerialTransport transport(bus.device(), true);
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	size_t sniffed = 0;
+	estiaSerial.onRawFrame([&](const FrameView&) { sniffed++; });
+
+	std::atomic<bool> stop(false);
+	std::atomic<size_t> sent(0);
+	std::thread heatPump([&] {
+		std::vector<uint8_t> frame;
+		while (!stop) {
+			uint8_t buffer[64];
+			ssize_t count = ::read(bus.fd, buffer, sizeof(buffer));
+			if (count <= 0) {
+				usleep(1000);
+				continue;
+			}
+			::write(bus.fd, buffer, count);    // echo
+			frame.insert(frame.end(), buffer, buffer + count);
+			if (frame.size() < 4 || frame.size() < frame[FRAME_DATA_LEN_OFFSET] + 6u) { continue; }
+
+			usleep(20000);
+			std::vector<uint8_t> reply;
+			if (frame[FRAME_TYPE_OFFSET] == FRAME_TYPE_CMD) {
+				reply = hexFrame("a0 00 18 09 00 08 00 08 00 00 a1 00 00 00 00");
+				reply[11] = frame[FRAME_DATA_TYPE_OFFSET];
+				reply[12] = frame[FRAME_DATA_TYPE_OFFSET + 1];
+				uint16_t crc = Crc16::calculate(reply.data(), reply.size() - 2);
+				reply[13] = crc >> 8;
+				reply[14] = crc & 0xff;
+			} else {
+				reply = hexFrame(twiResponse);
+			}
+			::write(bus.fd, reply.data(), reply.size());
+			sent++;
+			frame.clear();
+		}
+	});
+
+	// command is sent with RX enabled, request with RX disabled, echo of neither is sniffed
+	estiaSerial.forceDefrost(1);
+	int value = 1000;
+	CHECK(estiaSerial.requestDataAsync("twi", [&](int16_t response) { value = response; }));
+	uint16_t ack = 0;
+	uint32_t start = millis();
+	while (millis() - start < 3000 && value == 1000) {
+		transport.waitAvailable(2);
+		if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }
+		if (estiaSerial.frameAck) { ack = estiaSerial.getAck(); }
+	}
+	stop = true;
+	heatPump.join();
+	CHECK_EQ(ack, FRAME_DATA_TYPE_SPECIAL_CMD);
+	CHECK_EQ(value, 31);
+	CHECK_EQ(sent, 2);
+	CHECK_EQ(sniffed, 2);    // ack and response only
+}
+
+/** Read from transport until `len` bytes or `ms` passed. */
+static std::vector<uint8_t> readBytes(LinuxSerialTransport& transport, size_t len, uint32_t ms) {
+	std::vector<uint8_t> bytes;
+	uint32_t start = millis();
+	while (bytes.size() < len && millis() - start < ms) {
+		uint8_t buffer[64];
+		size_t count = transport.read(buffer, sizeof(buffer));
+		bytes.insert(bytes.end(), buffer, buffer + count);
+		if (count == 0) { transport.waitAvailable(2); }
+	}
+	return bytes;
+}
+
+/** Write returns without waiting for echo, only bytes matching written ones are dropped. */
+static void echoMatchTest() {
+	Bus bus;
+	LinuxSerialTransport transport(bus.device(), true);
+	CHECK(transport.begin());
+	std::vector<uint8_t> request = hexFrame(CAPTURED_REQUEST);
+	std::vector<uint8_t> status = hexFrame(statusFrame);
+
+	// echo and master frame right after it in one read
+	uint32_t start = micros();
+	CHECK_EQ(transport.write(request.data(), request.size()), request.size());
+	CHECK(micros() - start < 5000);
+	bus.receive();
+	bus.send(request);
+	bus.send(status);
+	CHECK(readBytes(transport, status.size(), 500) == status);
+
+	// master frame instead of echo is kept
+	transport.write(request.data(), request.size());
+	bus.send(status);
+	CHECK(readBytes(transport, status.size(), 500) == status);
+
+	// echo not received before line silence, later bytes equal to written ones are kept
+	transport.write(request.data(), request.size());
+	CHECK(readBytes(transport, 1, request.size() * ESTIA_SERIAL_CHAR_TIME / 1000 + LINUX_SERIAL_ECHO_TIMEOUT + 50).empty());
+	bus.send(request);
+	CHECK(readBytes(transport, request.size(), 500) == request);
+}
+
+int main() {
+	Bus bus;
+	CHECK(bus.fd >= 0);
+	LinuxSerialTransport transport(bus.device());
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+
+	// status frame received in two reads is closed by idle gap
+	std::vector<uint8_t> status = hexFrame(statusFrame);
+	bus.send(status, 0, 10);
+	transport.waitAvailable(100);
+	estiaSerial.sniffer();
+	CHECK(!estiaSerial.newStatusData);
+	bus.send(status, 10);
+	run(estiaSerial, transport, bus, 500, [&] { return estiaSerial.newStatusData; });
+	CHECK(estiaSerial.newStatusData);
+	StatusData& data = estiaSerial.getStatusData();
+	CHECK(data.extendedData);
+	CHECK_EQ(data.waterOutletTemperature, 52);
+	CHECK_EQ(data.waterInletTemperature, 31);
+
+	// data request goes out on the bus, response completes callback
+	int value = 1000;
+	CHECK(estiaSerial.requestDataAsync("twi", [&](int16_t response) { value = response; }));
+	run(estiaSerial, transport, bus, 1000, [&] { return !bus.received.empty(); });
+	run(estiaSerial, transport, bus, 50, [] { return false; });    // rest of the request
+	CHECK_EQ(bus.received.size(), 21);
+	if (bus.received.size() == 21) { CHECK_EQ(bus.received[17], CODE_TWI); }
+	bus.send(hexFrame(twiResponse));
+	run(estiaSerial, transport, bus, 1000, [&] { return value != 1000; });
+	CHECK_EQ(value, 31);
+
+	echoTest();
+	echoMatchTest();
+	return testResult("linux-serial-transport-test");
+}
@@ -0,0 +1,163 @@
+/*
+packed-status-test.cpp - lazy status decoding against eager reference
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "frames/status-frames.hpp"
+#include "test.hpp"
+
+/** Eager decoder all status fields were read with before `PackedStatus`, reference only. */
+static StatusData eagerDecode(const std::vector<uint8_t>& view) {
+	bool longFrame = view.size() == FRAME_STATUS_LEN;
+	StatusData data = {};
+	data.extendedData = longFrame;
+	data.operationMode = (view[11] & 0xe0) >> 5;
+	data.cooling = (view[11] & 0xa1) == 0xa1;
+	data.heating = (view[11] & 0xc1) == 0xc1;
+	data.hotWater = (view[11] & 0x02) >> 1 == 0x01;
+	data.autoMode = (view[12] & 0x04) >> 2 == 0x01;
+	data.quietMode = (view[12] & 0x10) >> 4 == 0x01;
+	data.nightMode = (view[12] & 0x20) >> 5 == 0x01;
+	data.backupHeater = (view[13] & 0x01) >> 0 == 0x01;
+	data.coolingCMP = (view[13] & 0x02) >> 1 == 0x01 && data.operationMode == 0x05;
+	data.heatingCMP = (view[13] & 0x02) >> 1 == 0x01 && data.operationMode == 0x06;
+	data.hotWaterHeater = (view[13] & 0x04) >> 2 == 0x01;
+	data.hotWaterCMP = (view[13] & 0x08) >> 3 == 0x01;
+	data.pump1 = (view[13] & 0x10) >> 4 == 0x01;
+	data.hotWaterTarget = view[14] / 0x02 - 0x10;
+	data.zone1Target = view[15] / 0x02 - 0x10;
+	data.zone2Target = view[16] / 0x02 - 0x10;
+	if (longFrame) {
+		data.hotWaterTarget2 = view[17] / 0x02 - 0x10;
+		data.zone1Target2 = view[18] / 0x02 - 0x10;
+		data.zone2Target2 = view[19] / 0x02 - 0x10;
+		data.defrostInProgress = (view[21] & 0x02) == 0x02;
+		data.nightModeActive = (view[21] & 0x10) == 0x10;
+		data.waterOutletTemperature = view[STATUS_TWO_OFFSET] / 0x02 - 0x10;
+		data.waterInletTemperature = view[STATUS_TWI_OFFSET] / 0x02 - 0x10;
+	} else {
+		data.defrostInProgress = (view[17] & 0x02) == 0x02;
+		data.nightModeActive = (view[17] & 0x10) == 0x10;
+	}
+	return data;
+}
+
+// update frame does not carry long frame fields, they are kept from previous status
+static StatusData eagerMerge(const StatusData& update, const StatusData& previous) {
+	StatusData merged = update;
+	merged.extendedData = previous.extendedData;
+	merged.hotWaterTarget2 = previous.hotWaterTarget2;
+	merged.zone1Target2 = previous.zone1Target2;
+	merged.zone2Target2 = previous.zone2Target2;
+	merged.waterOutletTemperature = previous.waterOutletTemperature;
+	merged.waterInletTemperature = previous.waterInletTemperature;
+	return merged;
+}
+
+/** Status read field by field with lazy accessors. */
+static StatusData accessors(const PackedStatus& packed) {
+	StatusData data = {};
+	data.extendedData = packed.extendedData();
+	data.operationMode = packed.operationMode();
+	data.cooling = packed.cooling();
+	data.heating = packed.heating();
+	data.hotWater = packed.hotWater();
+	data.autoMode = packed.autoMode();
+	data.quietMode = packed.quietMode();
+	data.nightMode = packed.nightMode();
+	data.backupHeater = packed.backupHeater();
+	data.coolingCMP = packed.coolingCMP();
+	data.heatingCMP = packed.heatingCMP();
+	data.hotWaterHeater = packed.hotWaterHeater();
+	data.hotWaterCMP = packed.hotWaterCMP();
+	data.pump1 = packed.pump1();
+	data.hotWaterTarget = packed.hotWaterTarget();
+	data.zone1Target = packed.zone1Target();
+	data.zone2Target = packed.zone2Target();
+	data.hotWaterTarget2 = packed.hotWaterTarget2();
+	data.zone1Target2 = packed.zone1Target2();
+	data.zone2Target2 = packed.zone2Target2();
+	data.defrostInProgress = packed.defrostInProgress();
+	data.nightModeActive = packed.nightModeActive();
+	data.waterOutletTemperature = packed.waterOutletTemperature();
+	data.waterInletTemperature = packed.waterInletTemperature();
+	return data;
+}
+
+/** @param fields fields to compare, all by default */
+static void checkSame(const StatusData& actual, const StatusData& expected, uint32_t fields = UINT32_MAX) {
+	StatusChanges differ = StatusChanges::compare(expected, actual);
+	for (StatusChanges::Field field : differ) {
+		if (!(fields & (UINT32_C(1) << field))) { continue; }
+		fprintf(stderr, "  %s: %d, expected %d\n", StatusChanges::name(field), StatusChanges::value(actual, field), StatusChanges::value(expected, field));
+	}
+	CHECK_EQ(differ.mask & fields, 0);
+}
+
+// fields carried by update frame
+static constexpr uint32_t updateFields = ~((UINT32_C(1) << StatusChanges::field_extended_data) |
+                                           (UINT32_C(1) << StatusChanges::field_hot_water_target2) |
+                                           (UINT32_C(1) << StatusChanges::field_zone1_target2) |
+                                           (UINT32_C(1) << StatusChanges::field_zone2_target2) |
+                                           (UINT32_C(1) << StatusChanges::field_water_outlet_temperature) |
+                                           (UINT32_C(1) << StatusChanges::field_water_inlet_temperature));
+
+static void longFramesTest() {
+	for (const CapturedStatus& captured : capturedStatus) {
+		std::vector<uint8_t> bytes = hexFrame(captured.frame);
+		StatusFrame frame(FrameView(bytes.data(), bytes.size()), bytes.size());
+		CHECK_EQ(frame.error, FrameError::err_ok);
+		StatusData expected = eagerDecode(bytes);
+		checkSame(frame.decode(), expected);
+		checkSame(accessors(frame.pack()), expected);
+	}
+}
+
+static void updateFramesTest() {
+	for (const char* update : capturedUpdates) {
+		std::vector<uint8_t> bytes = hexFrame(update);
+		StatusFrame frame(FrameView(bytes.data(), bytes.size()), bytes.size());
+		CHECK_EQ(frame.error, FrameError::err_ok);
+		StatusData expected = eagerDecode(bytes);
+		checkSame(frame.decode(), expected, updateFields);
+		checkSame(accessors(frame.pack()), expected, updateFields);
+		CHECK(!frame.decode().extendedData);
+	}
+}
+
+// update merged into every long status, as old decode(previous)
+static void mergeTest() {
+	for (const CapturedStatus& captured : capturedStatus) {
+		std::vector<uint8_t> status = hexFrame(captured.frame);
+		for (const char* update : capturedUpdates) {
+			std::vector<uint8_t> bytes = hexFrame(update);
+			PackedStatus packed = StatusFrame(FrameView(status.data(), status.size()), status.size()).pack();
+			packed.merge(StatusFrame(FrameView(bytes.data(), bytes.size()), bytes.size()).pack());
+			StatusData expected = eagerMerge(eagerDecode(bytes), eagerDecode(status));
+			checkSame(packed.unpack(), expected);
+			checkSame(accessors(packed), expected);
+		}
+	}
+}
+
+int main() {
+	longFramesTest();
+	updateFramesTest();
+	mergeTest();
+	return testResult("packed-status-test");
+}
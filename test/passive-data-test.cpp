@@ -0,0 +1,109 @@
+/*
+passive-data-test.cpp - values harvested from other device requests
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "estia-serial.hpp"
+#include "test.hpp"
+
+#define CHAR_TIME ESTIA_SERIAL_CHAR_TIME
+
+/** Frame received from bus, sniffer runs after its last byte. */
+static void receive(EstiaSerial& estiaSerial, MemoryTransport& transport, const char* frame) {
+	std::vector<uint8_t> bytes = hexFrame(frame);
+	transport.receive(bytes);
+	transport.now += bytes.size() * CHAR_TIME;
+	if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }
+}
+
+/** Run sniffer for `ms` (real time), answer own requests with captured response.
+*
+* @return codes of transmitted requests
+*/
+static std::vector<uint8_t> run(EstiaSerial& estiaSerial, MemoryTransport& transport, uint32_t ms) {
+	std::vector<uint8_t> requested;
+	uint32_t start = millis();
+	while (millis() - start < ms) {
+		transport.now += 1000;
+		if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }
+		if (transport.tx.size() >= FRAME_REQ_DATA_LEN) {
+			requested.push_back(transport.tx[REQ_DATA_CODE_OFFSET]);
+			transport.tx.clear();
+			transport.receive(hexFrame(CAPTURED_RESPONSE));
+		}
+		delay(1);
+	}
+	return requested;
+}
+
+// remote controller request (TWI) and heat pump response, value stored as passive
+static void harvestTest() {
+	MemoryTransport transport;
+	transport.now = 5000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	receive(estiaSerial, transport, CAPTURED_REQUEST);
+	receive(estiaSerial, transport, CAPTURED_RESPONSE);
+	const SensorStore& sensors = estiaSerial.getSensors();
+	CHECK_EQ(sensors.value(CODE_TWI), 31);
+	CHECK(sensors.passive(CODE_TWI));
+	CHECK_EQ(estiaSerial.getPollScheduler().getObserved(), 1);
+
+	// response without request is not harvested again
+	estiaSerial.clearSensorsData();
+	receive(estiaSerial, transport, CAPTURED_RESPONSE);
+	CHECK(!sensors.has(CODE_TWI));
+}
+
+// response later than request timeout belongs to no request
+static void lateResponseTest() {
+	MemoryTransport transport;
+	transport.now = 5000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	receive(estiaSerial, transport, CAPTURED_REQUEST);
+	delay(REQUEST_TIMEOUT + 10);
+	receive(estiaSerial, transport, CAPTURED_RESPONSE);
+	CHECK(!estiaSerial.getSensors().has(CODE_TWI));
+	CHECK_EQ(estiaSerial.getPollScheduler().getObserved(), 0);
+}
+
+// fresh passive value replaces sweep request and delays polled request by one period
+static void schedulerTest() {
+	MemoryTransport transport;
+	transport.now = 5000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	receive(estiaSerial, transport, CAPTURED_REQUEST);
+	receive(estiaSerial, transport, CAPTURED_RESPONSE);
+
+	CHECK(estiaSerial.requestSensorsData({"twi", "two"}));
+	std::vector<uint8_t> requested = run(estiaSerial, transport, 300);
+	CHECK(estiaSerial.newSensorsData);
+	CHECK(requested == std::vector<uint8_t>({CODE_TWO}));
+
+	CHECK(estiaSerial.pollSensor("twi", 1000));
+	CHECK(run(estiaSerial, transport, 300).empty());
+}
+
+int main() {
+	harvestTest();
+	lateResponseTest();
+	schedulerTest();
+	return testResult("passive-data-test");
+}
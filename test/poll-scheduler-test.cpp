@@ -0,0 +1,131 @@
+/*
+poll-scheduler-test.cpp - polled requests, periods and backoff
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "estia-serial.hpp"
+#include "test.hpp"
+
+#define POLL_TEST_PERIOD 200    // ms
+
+/** Run sniffer for `ms` (real time, 1 ms transport steps), answer own requests with captured response.
+*
+* @return codes of transmitted requests
+*/
+static std::vector<uint8_t> run(EstiaSerial& estiaSerial, MemoryTransport& transport, uint32_t ms) {
+	std::vector<uint8_t> requested;
+	uint32_t start = millis();
+	while (millis() - start < ms) {
+		transport.now += 1000;
+		if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }
+		if (transport.tx.size() >= FRAME_REQ_DATA_LEN) {
+			requested.push_back(transport.tx[REQ_DATA_CODE_OFFSET]);
+			transport.tx.clear();
+			transport.receive(hexFrame(CAPTURED_RESPONSE));
+		}
+		delay(1);
+	}
+	return requested;
+}
+
+/** Frame received from bus, sniffer runs after its last byte. */
+static void receive(EstiaSerial& estiaSerial, MemoryTransport& transport, const char* frame) {
+	std::vector<uint8_t> bytes = hexFrame(frame);
+	transport.receive(bytes);
+	transport.now += bytes.size() * ESTIA_SERIAL_CHAR_TIME;
+	if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }
+}
+
+// stable value doubles interval up to cap, changed value and wake() restore period
+static void backoffTest() {
+	PollScheduler scheduler;
+	scheduler.setAdaptive(true, 3);
+	CHECK(scheduler.setPeriod(CODE_TWO, 1000, PollScheduler::priority_normal, 0));
+	CHECK(scheduler.setPeriod(CODE_TWI, 1000, PollScheduler::priority_normal, 0));
+	scheduler.received(CODE_TWO, 50);
+	CHECK_EQ(scheduler.getInterval(CODE_TWO), 1000);
+	for (uint32_t interval : {2000, 4000, 8000, 8000}) {
+		scheduler.received(CODE_TWO, 50);
+		CHECK_EQ(scheduler.getInterval(CODE_TWO), interval);
+	}
+	scheduler.received(CODE_TWO, 51);
+	CHECK_EQ(scheduler.getInterval(CODE_TWO), 1000);
+
+	// sweep requests sensor with backoff 2 every 4th time
+	scheduler.received(CODE_TWO, 51);
+	scheduler.received(CODE_TWO, 51);
+	std::vector<bool> sweeps;
+	for (int sweep = 0; sweep < 8; sweep++) { sweeps.push_back(scheduler.sweep(CODE_TWO)); }
+	CHECK(sweeps == std::vector<bool>({false, false, false, true, true, true, true, true}));    // no value received after 4th
+
+	for (int16_t value : {30, 30, 30}) { scheduler.received(CODE_TWI, value); }
+	CHECK_EQ(scheduler.getInterval(CODE_TWI), 4000);
+	scheduler.wake();
+	CHECK_EQ(scheduler.getInterval(CODE_TWO), 1000);
+	CHECK_EQ(scheduler.getInterval(CODE_TWI), 1000);
+}
+
+// status frame with changed operation fields restores polling periods
+static void wakeTest() {
+	MemoryTransport transport;
+	transport.now = 5000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	estiaSerial.setAdaptivePolling(true);
+	receive(estiaSerial, transport, capturedStatus[0].frame);
+	CHECK(estiaSerial.pollSensor("two", 50));
+	run(estiaSerial, transport, 1000);
+	CHECK_EQ(estiaSerial.getPollScheduler().getInterval(CODE_TWO), 50 << POLL_ADAPTIVE_MAX_BACKOFF);
+
+	estiaSerial.getStatusData();
+	receive(estiaSerial, transport, capturedStatus[3].frame);    // modes and targets changed
+	CHECK(estiaSerial.newStatusData);
+	CHECK_EQ(estiaSerial.getPollScheduler().getInterval(CODE_TWO), 50 << POLL_ADAPTIVE_MAX_BACKOFF);
+	receive(estiaSerial, transport, capturedStatus[1].frame);    // heating compressor changed
+	CHECK_EQ(estiaSerial.getPollScheduler().getInterval(CODE_TWO), 50);
+}
+
+// response to other device request does not complete queued polled request, sensor keeps being polled
+static void foreignResponseTest() {
+	MemoryTransport transport;
+	transport.now = 5000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	CHECK(estiaSerial.pollSensor("two", POLL_TEST_PERIOD));
+
+	// polled request queued, line not idle long enough to send it
+	estiaSerial.sniffer();
+	CHECK(transport.tx.empty());
+	transport.receive(hexFrame(CAPTURED_RESPONSE));
+	transport.now += FRAME_RES_DATA_LEN * ESTIA_SERIAL_CHAR_TIME;
+	estiaSerial.sniffer();
+	CHECK(!estiaSerial.getSensors().has(CODE_TWO));
+
+	std::vector<uint8_t> requested = run(estiaSerial, transport, POLL_TEST_PERIOD * 2 + 100);
+	CHECK(requested.size() >= 2);
+	for (uint8_t code : requested) { CHECK_EQ(code, CODE_TWO); }
+	CHECK_EQ(estiaSerial.getSensors().value(CODE_TWO), 31);
+	CHECK(!estiaSerial.getSensors().passive(CODE_TWO));
+}
+
+int main() {
+	foreignResponseTest();
+	backoffTest();
+	wakeTest();
+	return testResult("poll-scheduler-test");
+}
@@ -0,0 +1,82 @@
+/*
+received-frames-test.cpp - in place frame decoders and single CRC check
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "estia-serial.hpp"
+#include "test.hpp"
+#include <type_traits>
+
+static_assert(!std::is_constructible<StatusFrame, FrameBuffer&&, uint8_t>::value, "temporary frame would dangle");
+static_assert(!std::is_constructible<StatusFrame, ReadBuffer&, uint8_t>::value, "temporary frame would dangle");
+static_assert(!std::is_constructible<DataResFrame, FrameBuffer&&>::value, "temporary frame would dangle");
+static_assert(!std::is_constructible<DataResFrame, ReadBuffer&>::value, "temporary frame would dangle");
+static_assert(!std::is_constructible<AckFrame, FrameBuffer&&>::value, "temporary frame would dangle");
+static_assert(!std::is_constructible<AckFrame, ReadBuffer&>::value, "temporary frame would dangle");
+
+static const char* ackFrame = "a0 00 18 09 00 08 00 08 00 00 a1 00 41 c1 95";
+static const char* responseFrame = "a0 00 1a 0d 00 08 00 00 40 00 ef 00 80 00 2c 00 1f 73 83";
+static const char* statusFrame = "a0 00 58 19 00 08 00 00 fe 03 c6 c1 30 10 78 5c 7a 78 5c 7a 00 00 00 00 00 e9 89 5e 00 41 4a";
+
+static void decodeTest() {
+	std::vector<uint8_t> ackBytes = hexFrame(ackFrame);
+	FrameBuffer ack(ackBytes.begin(), ackBytes.end());
+	AckFrame ackDecoded(ack);
+	CHECK_EQ(ackDecoded.error, FrameError::err_ok);
+	CHECK_EQ(ackDecoded.frameCode, 0x0041);
+	CHECK(ackDecoded.data() == ack.data());    // no copy
+
+	std::vector<uint8_t> response = hexFrame(responseFrame);
+	DataResFrame responseDecoded(FrameView(response.data(), response.size(), FrameView::crc_valid));
+	CHECK_EQ(responseDecoded.error, FrameError::err_ok);
+	CHECK_EQ(responseDecoded.value, 31);
+
+	std::vector<uint8_t> status = hexFrame(statusFrame);
+	StatusFrame statusDecoded(FrameView(status.data(), status.size()), status.size());
+	CHECK_EQ(statusDecoded.error, FrameError::err_ok);
+	status[12] ^= 0x01;
+	StatusFrame corrupted(FrameView(status.data(), status.size()), status.size());
+	CHECK_EQ(corrupted.error, FrameError::err_crc);
+}
+
+// assembler checks CRC once, state is passed with frame
+static void crcStateTest() {
+	FramePool pool;
+	CHECK(pool.allocate(4));
+	FrameAssembler assembler;
+	std::vector<FrameView::CrcState> states;
+	assembler.onFrame([&](FrameBuffer&, FrameView::CrcState crc) { states.push_back(crc); });
+
+	std::vector<uint8_t> bytes = hexFrame(ackFrame);
+	assembler.push(bytes.data(), bytes.size(), pool);
+	bytes[12] ^= 0x01;
+	assembler.push(bytes.data(), bytes.size(), pool);
+	assembler.push(bytes.data(), 5, pool);
+	assembler.flush(pool);
+	CHECK_EQ(states.size(), 3);
+	if (states.size() == 3) {
+		CHECK_EQ(states[0], FrameView::crc_valid);
+		CHECK_EQ(states[1], FrameView::crc_invalid);
+		CHECK_EQ(states[2], FrameView::crc_unchecked);    // closed before end, left to frame fixer
+	}
+}
+
+int main() {
+	decodeTest();
+	crcStateTest();
+	return testResult("received-frames-test");
+}
@@ -0,0 +1,50 @@
+/*
+requests-map-test.cpp - data names lookup in flash catalog
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "sensor-store.hpp"
+#include "test.hpp"
+
+// every descriptor name resolves to its code
+static void namesTest() {
+	CHECK_EQ(requestsMap.size(), SENSORS_COUNT);
+	for (uint8_t idx = 0; idx < SENSORS_COUNT; idx++) {
+		SensorDescriptor descriptor = SensorStore::descriptor(idx);
+		uint8_t code = 0;
+		CHECK(requestsMap.find(descriptor.name, code));
+		CHECK_EQ(code, descriptor.code);
+		CHECK(SensorStore::multiplier(descriptor.name) == descriptor.multiplier);
+	}
+}
+
+// only whole names match, value untouched on failure
+static void unknownTest() {
+	const char* names[] = {"", "unknown", "tw", "t", "twi_", "twix", "lp", "lpss", "TWI", "hp_on", "zzz"};
+	for (const char* name : names) {
+		uint8_t code = 0xaa;
+		CHECK(!requestsMap.find(name, code));
+		CHECK_EQ(code, 0xaa);
+		CHECK(SensorStore::multiplier(name) == 0);
+	}
+}
+
+int main() {
+	namesTest();
+	unknownTest();
+	return testResult("requests-map-test");
+}
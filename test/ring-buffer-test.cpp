@@ -0,0 +1,89 @@
+/*
+ring-buffer-test.cpp - SPSC ring buffer with producer and consumer threads
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "frames/ring-buffer.hpp"
+#include "test.hpp"
+#include <atomic>
+#include <thread>
+
+#define RING_TEST_BYTES 1000000UL
+
+// single thread: wrap around, peek spans, overflow counting
+static void singleThreadTest() {
+	RingBuffer<uint8_t, 8> ring;
+	for (uint8_t idx = 0; idx < 8; idx++) { CHECK(ring.push_back(idx)); }
+	CHECK(ring.full());
+	CHECK(!ring.push_back(8));
+	CHECK_EQ(ring.overflows(), 1);
+
+	ring.consume(6);
+	CHECK(ring.push_back(8));
+	CHECK(ring.push_back(9));
+	const uint8_t* data;
+	CHECK_EQ(ring.peek(data), 2);    // up to buffer end
+	CHECK_EQ(data[0], 6);
+	ring.consume(2);
+	CHECK_EQ(ring.peek(data), 2);    // wrapped part
+	CHECK_EQ(data[1], 9);
+	ring.clear();
+	CHECK(ring.empty());
+}
+
+// producer pushes counter bytes, consumer checks order, nothing lost or duplicated
+static void threadedTest() {
+	static RingBuffer<uint8_t, 64> ring;
+	std::atomic<uint32_t> overflows(0);
+	std::thread producer([&] {
+		for (uint32_t count = 0; count < RING_TEST_BYTES;) {
+			if (ring.push_back(static_cast<uint8_t>(count))) {
+				count++;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		overflows = ring.overflows();
+	});
+
+	uint32_t received = 0;
+	uint32_t errors = 0;
+	while (received < RING_TEST_BYTES) {
+		const uint8_t* data;
+		size_t len = ring.peek(data);
+		if (len == 0) {
+			std::this_thread::yield();
+			continue;
+		}
+		for (size_t idx = 0; idx < len; idx++) {
+			if (data[idx] != static_cast<uint8_t>(received + idx)) { errors++; }
+		}
+		ring.consume(len);
+		received += len;
+	}
+	producer.join();
+	CHECK_EQ(received, RING_TEST_BYTES);
+	CHECK_EQ(errors, 0);
+	CHECK(ring.empty());
+	CHECK_EQ(ring.overflows(), overflows);    // rejected pushes are counted, retried by producer
+}
+
+int main() {
+	singleThreadTest();
+	threadedTest();
+	return testResult("ring-buffer-test");
+}
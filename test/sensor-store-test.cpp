@@ -0,0 +1,93 @@
+/*
+sensor-store-test.cpp - sensors lookup, scaling and iteration
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "sensor-store.hpp"
+#include "test.hpp"
+#include <vector>
+
+#define SENSOR_UNKNOWN_CODE 0x05
+
+// code and name map to the same descriptor
+static void indexTest() {
+	uint8_t idx = SensorStore::index(CODE_LPS);
+	CHECK(idx != SENSOR_NONE);
+	CHECK_EQ(SensorStore::index(std::string("lps")), idx);
+	SensorDescriptor descriptor = SensorStore::descriptor(idx);
+	CHECK_EQ(descriptor.code, CODE_LPS);
+	CHECK(strcmp(descriptor.name, "lps") == 0);
+	CHECK(strcmp(descriptor.unit, "kPa") == 0);
+
+	for (uint8_t idx = 0; idx < SENSORS_COUNT; idx++) {
+		SensorDescriptor descriptor = SensorStore::descriptor(idx);
+		CHECK_EQ(SensorStore::index(descriptor.code), idx);
+		CHECK_EQ(SensorStore::index(std::string(descriptor.name)), idx);
+	}
+	CHECK_EQ(SensorStore::index(SENSOR_UNKNOWN_CODE), SENSOR_NONE);
+	CHECK_EQ(SensorStore::index(std::string("unknown")), SENSOR_NONE);
+	CHECK_EQ(SensorStore::index(std::string("")), SENSOR_NONE);
+}
+
+static void setTest() {
+	SensorStore store;
+	CHECK(store.empty());
+	CHECK(!store.set(SENSOR_UNKNOWN_CODE, 10, 1000));
+	CHECK(store.empty());
+	CHECK(!store.has(SENSOR_UNKNOWN_CODE));
+	CHECK_EQ(store.value(SENSOR_UNKNOWN_CODE), 0);
+	CHECK(store.scaled(SENSOR_UNKNOWN_CODE) == 0);
+
+	CHECK(store.set(CODE_LPS, 12, 1000));
+	CHECK(store.set(CODE_WF, 250, 2000, false, true));
+	CHECK(store.set(CODE_TO, -3, 3000, true));
+	CHECK_EQ(store.size(), 3);
+	CHECK(store.scaled(CODE_LPS) == 120);
+	CHECK(store.scaled(CODE_WF) == 250 * 0.1F);
+	CHECK_EQ(store.state(CODE_TO), SensorStore::sensor_error);
+	CHECK_EQ(store.updated(CODE_WF), 2000);
+	CHECK(store.passive(CODE_WF));
+	CHECK(!store.passive(CODE_LPS));
+
+	store.clear();
+	CHECK(store.empty());
+	CHECK(!store.has(CODE_LPS));
+}
+
+// only sensors with data, in descriptor table order
+static void iterationTest() {
+	SensorStore store;
+	CHECK(!(store.begin() != store.end()));
+
+	std::vector<uint8_t> codes = {CODE_BOOST_HEATER_ON_TIME, CODE_TWI, CODE_CT};
+	for (uint8_t code : codes) { CHECK(store.set(code, 1, 0)); }
+	std::vector<uint8_t> iterated;
+	for (const SensorStore::Reading& reading : store) {
+		CHECK(reading.state != SensorStore::sensor_empty);
+		CHECK(reading.scaled() == reading.descriptor.multiplier);
+		iterated.push_back(reading.descriptor.code);
+	}
+	std::vector<uint8_t> expected = {CODE_TWI, CODE_CT, CODE_BOOST_HEATER_ON_TIME};
+	CHECK(iterated == expected);
+}
+
+int main() {
+	indexTest();
+	setTest();
+	iterationTest();
+	return testResult("sensor-store-test");
+}
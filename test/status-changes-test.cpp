@@ -0,0 +1,108 @@
+/*
+status-changes-test.cpp - status change masks and notifications
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "estia-serial.hpp"
+#include "test.hpp"
+
+/** Status fed to EstiaSerial, notifications collected. */
+class StatusBus {
+  public:
+	MemoryTransport transport;
+	EstiaSerial estiaSerial;
+	std::vector<StatusChanges> notified;
+	PackedStatus expected;    // independently merged status
+
+	StatusBus()
+	    : estiaSerial(transport) {
+		transport.now = 5000000;
+		CHECK(estiaSerial.begin());
+		estiaSerial.onStatusChange([this](const StatusData&, StatusChanges changes) { notified.push_back(changes); });
+	}
+
+	/** @return fields with different value after frame, compared field by field */
+	StatusChanges receive(const char* frame) {
+		std::vector<uint8_t> bytes = hexFrame(frame);
+		StatusData before = expected.unpack();
+		expected.merge(StatusFrame(FrameView(bytes.data(), bytes.size()), bytes.size()).pack());
+		StatusData after = expected.unpack();
+		StatusChanges changed;
+		for (uint8_t field = 0; field < StatusChanges::field_count; field++) {
+			StatusChanges::Field name = static_cast<StatusChanges::Field>(field);
+			changed.set(name, StatusChanges::value(before, name) != StatusChanges::value(after, name));
+		}
+		transport.receive(bytes);
+		transport.now += bytes.size() * ESTIA_SERIAL_CHAR_TIME;
+		if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }
+		return changed;
+	}
+};
+
+// first status reports all fields, identical one nothing
+static void firstStatusTest() {
+	StatusBus bus;
+	bus.receive(capturedStatus[0].frame);
+	CHECK_EQ(bus.notified.size(), 1);
+	CHECK(bus.notified.size() == 1 && bus.notified[0].mask == StatusChanges::all().mask);
+	CHECK_EQ(bus.estiaSerial.getStatusChanges().mask, StatusChanges::all().mask);
+	bus.estiaSerial.getStatusData();
+
+	bus.receive(capturedStatus[0].frame);
+	CHECK_EQ(bus.notified.size(), 1);
+	CHECK(!bus.estiaSerial.newStatusData);
+}
+
+// update frame sets only fields it changed, never temperatures it does not carry
+static void updateTest() {
+	for (const char* update : capturedUpdates) {
+		StatusBus bus;
+		bus.receive(capturedStatus[0].frame);
+		StatusChanges changed = bus.receive(update);
+		CHECK(!changed.empty());
+		CHECK_EQ(bus.notified.size(), 2);
+		CHECK(bus.notified.size() == 2 && bus.notified[1].mask == changed.mask);
+		CHECK(!changed.has(StatusChanges::field_water_outlet_temperature));
+		CHECK(!changed.has(StatusChanges::field_water_inlet_temperature));
+		CHECK_EQ(bus.estiaSerial.getStatusData().waterOutletTemperature, capturedStatus[0].two);
+	}
+}
+
+// masks accumulate until status is read
+static void accumulateTest() {
+	StatusBus bus;
+	bus.receive(capturedStatus[0].frame);
+	bus.estiaSerial.getStatusData();
+	StatusChanges first = bus.receive(capturedStatus[1].frame);
+	StatusChanges second = bus.receive(capturedStatus[3].frame);
+	CHECK(first.mask != second.mask);
+	CHECK_EQ(bus.notified.size(), 3);
+	CHECK(bus.notified.size() == 3 && bus.notified[1].mask == first.mask && bus.notified[2].mask == second.mask);
+	CHECK_EQ(bus.estiaSerial.getStatusChanges().mask, first.mask | second.mask);
+
+	bus.estiaSerial.getStatusData();
+	StatusChanges third = bus.receive(capturedStatus[0].frame);
+	CHECK_EQ(bus.estiaSerial.getStatusChanges().mask, third.mask);
+}
+
+int main() {
+	firstStatusTest();
+	updateTest();
+	accumulateTest();
+	return testResult("status-changes-test");
+}
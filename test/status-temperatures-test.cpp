@@ -0,0 +1,82 @@
+/*
+status-temperatures-test.cpp - TWO/TWI from captured long status frames
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "captured-frames.hpp"
+#include "estia-serial.hpp"
+#include "test.hpp"
+
+// bytes 26/27 of long status frame, `value / 2 - 16`
+static void decodeTest() {
+	for (const CapturedStatus& captured : capturedStatus) {
+		std::vector<uint8_t> bytes = hexFrame(captured.frame);
+		StatusFrame frame(FrameView(bytes.data(), bytes.size()), bytes.size());
+		StatusData data = frame.decode();
+		CHECK_EQ(data.error, FrameError::err_ok);
+		CHECK(data.extendedData);
+		CHECK_EQ(data.waterOutletTemperature, captured.two);
+		CHECK_EQ(data.waterInletTemperature, captured.twi);
+	}
+	// update frame has no temperatures, merged status keeps last ones
+	std::vector<uint8_t> status = hexFrame(capturedStatus[0].frame);
+	std::vector<uint8_t> update = hexFrame(capturedUpdates[0]);
+	StatusFrame updateFrame(FrameView(update.data(), update.size()), update.size());
+	CHECK(!updateFrame.decode().extendedData);
+	PackedStatus packed = StatusFrame(FrameView(status.data(), status.size()), status.size()).pack();
+	packed.merge(updateFrame.pack());
+	CHECK_EQ(packed.unpack().waterOutletTemperature, capturedStatus[0].two);
+	CHECK_EQ(packed.unpack().waterInletTemperature, capturedStatus[0].twi);
+}
+
+// status temperatures are stored as passive readings and not requested while recent
+static void sweepTest() {
+	MemoryTransport transport;
+	transport.now = 1000000;
+	EstiaSerial estiaSerial(transport);
+	CHECK(estiaSerial.begin());
+	estiaSerial.setStatusTemperatures(true);
+
+	transport.receive(hexFrame(capturedStatus[2].frame));
+	estiaSerial.sniffer();
+	const SensorStore& sensors = estiaSerial.getSensors();
+	CHECK_EQ(sensors.value(CODE_TWO), capturedStatus[2].two);
+	CHECK_EQ(sensors.value(CODE_TWI), capturedStatus[2].twi);
+	CHECK(sensors.passive(CODE_TWO) && sensors.passive(CODE_TWI));
+
+	CHECK(estiaSerial.requestSensorsData({"two", "twi", "tc"}));
+	std::vector<uint8_t> requested;
+	uint32_t start = millis();
+	while (millis() - start < 1000 && !estiaSerial.newSensorsData) {
+		transport.now += 1000;
+		if (estiaSerial.sniffer() == EstiaSerial::sniff_frame_pending) { estiaSerial.getSniffedFrame(); }
+		if (transport.tx.size() >= FRAME_REQ_DATA_LEN) {
+			requested.push_back(transport.tx[REQ_DATA_CODE_OFFSET]);
+			transport.tx.clear();
+			transport.receive(hexFrame(CAPTURED_RESPONSE));
+		}
+		delay(1);
+	}
+	CHECK(estiaSerial.newSensorsData);
+	CHECK(requested == std::vector<uint8_t>({CODE_TC}));
+}
+
+int main() {
+	decodeTest();
+	sweepTest();
+	return testResult("status-temperatures-test");
+}
@@ -0,0 +1,100 @@
+/*
+test.hpp - Estia R32 heat pump serial host test helpers
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include "transport/transport.hpp"
+#include <deque>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+static int testFailures = 0;
+
+#define CHECK(cond) check((cond), #cond, __FILE__, __LINE__)
+#define CHECK_EQ(actual, expected) checkEqual((actual), (expected), #actual, __FILE__, __LINE__)
+
+inline void check(bool passed, const char* expression, const char* file, int line) {
+	if (passed) { return; }
+	fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+	testFailures++;
+}
+
+inline void checkEqual(long long actual, long long expected, const char* expression, const char* file, int line) {
+	if (actual == expected) { return; }
+	fprintf(stderr, "%s:%d: %s == %lld, expected %lld\n", file, line, expression, actual, expected);
+	testFailures++;
+}
+
+/** Test exit code, prints summary. */
+inline int testResult(const char* name) {
+	if (testFailures != 0) {
+		fprintf(stderr, "%s: %d check(s) failed\n", name, testFailures);
+		return 1;
+	}
+	printf("%s: ok\n", name);
+	return 0;
+}
+
+/** Parse `a0 00 10 ...` frame dump (frames.md format). */
+inline std::vector<uint8_t> hexFrame(const char* hex) {
+	std::vector<uint8_t> bytes;
+	unsigned int byte;
+	int read;
+	while (sscanf(hex, "%x%n", &byte, &read) == 1) {
+		bytes.push_back(byte);
+		hex += read;
+	}
+	return bytes;
+}
+
+/** In memory serial line, test queues received bytes and sets time. */
+class MemoryTransport : public Transport {
+  public:
+	std::deque<uint8_t> rx;
+	std::vector<uint8_t> tx;
+	uint32_t now;    // us
+	bool rxEnabled;
+
+	MemoryTransport()
+	    : now(0)
+	    , rxEnabled(true) {
+	}
+
+	bool begin() override { return true; }
+	size_t available() override { return rx.size(); }
+	size_t read(uint8_t* buffer, size_t len) override {
+		size_t count = 0;
+		while (count < len && !rx.empty()) {
+			buffer[count++] = rx.front();
+			rx.pop_front();
+		}
+		return count;
+	}
+	size_t write(const uint8_t* buffer, size_t len) override {
+		tx.insert(tx.end(), buffer, buffer + len);
+		return len;
+	}
+	void enableTx(bool enable) override { (void)enable; }
+	void enableRx(bool enable) override { rxEnabled = enable; }
+	void flushRx() override {}
+	uint32_t timestamp() override { return now; }
+
+	void receive(const std::vector<uint8_t>& bytes) { rx.insert(rx.end(), bytes.begin(), bytes.end()); }
+};
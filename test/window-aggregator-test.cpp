@@ -0,0 +1,65 @@
+/*
+window-aggregator-test.cpp - packed window record values
+Copyright (C) 2025 serek4. All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "window-aggregator.hpp"
+#include "test.hpp"
+
+#define WINDOW_TEST_LENGTH 60000    // ms
+
+static int32_t getInt32(const uint8_t* data) {
+	return static_cast<int32_t>(static_cast<uint32_t>(data[0]) << 24 | data[1] << 16 | data[2] << 8 | data[3]);
+}
+
+// mean x10 of values near int16 limits is packed without overflow
+static void packedMeanTest() {
+	WindowAggregator aggregator;
+	WindowRecord closed = {};
+	bool windowClosed = false;
+	aggregator.onWindow([&](const WindowRecord& window) {
+		closed = window;
+		windowClosed = true;
+	});
+	aggregator.begin(WINDOW_TEST_LENGTH, 0);
+	aggregator.sample(CODE_TWO, 32000, 1000);
+	aggregator.sample(CODE_TWO, 32001, 2000);
+	aggregator.sample(CODE_TWI, -32000, 3000);
+	aggregator.tick(WINDOW_TEST_LENGTH);
+	CHECK(windowClosed);
+
+	uint8_t packed[WINDOW_PACKED_HEADER_LEN + SENSORS_COUNT * WINDOW_PACKED_SENSOR_LEN + WindowRecord::duty_count * WINDOW_PACKED_DUTY_LEN];
+	size_t len = closed.pack(packed, sizeof(packed));
+	CHECK_EQ(len, closed.packedSize());
+	CHECK_EQ(packed[8], 2);    // sensors count
+	// sensors in `SensorStore` order, mean after code, count, min, max, last
+	const uint8_t* sensor = packed + WINDOW_PACKED_HEADER_LEN;
+	for (uint8_t idx = 0; idx < 2; idx++, sensor += WINDOW_PACKED_SENSOR_LEN) {
+		if (sensor[0] == CODE_TWO) {
+			CHECK_EQ(getInt32(sensor + 9), 320005);
+		} else {
+			CHECK_EQ(sensor[0], CODE_TWI);
+			CHECK_EQ(getInt32(sensor + 9), -320000);
+		}
+	}
+	CHECK_EQ(closed.pack(packed, len - 1), 0);
+}
+
+int main() {
+	packedMeanTest();
+	return testResult("window-aggregator-test");
+}